@@ -43,6 +43,16 @@ HookReturnCode MainFunc( const string& in szString )
 	return HOOK_CONTINUE;
 }
 
+//This hook deliberately triggers a null pointer exception so the event system quarantines it.
+HookReturnCode ThrowingHook( const string& in szString )
+{
+	dictionary@ pDict = null;
+	
+	Print( "Value: " + pDict.getKeys()[ 0 ] + "\n" );
+	
+	return HOOK_CONTINUE;
+}
+
 void Func( const string& in szString )
 {
 	Print( szString + "\n" );
@@ -53,6 +63,95 @@ void NoArgs()
 	Print( "No arguments works\n" );
 }
 
+int g_iNestedCalls = 0;
+
+void NestedTarget()
+{
+	++g_iNestedCalls;
+}
+
+//Makes nested calls on this script's context, and checks that this function's state survived them.
+bool TestNestedCalls()
+{
+	g_iNestedCalls = 0;
+	
+	const string szLocal = "outer";
+	
+	if( !CallNested( "NestedTarget", 2 ) )
+		return false;
+	
+	return g_iNestedCalls == 2 && szLocal == "outer";
+}
+
+bool TestOwningContextNesting()
+{
+	return !IsOwningContextBorrowed( false ) && IsOwningContextBorrowed( true );
+}
+
+bool TestEnumArgument( HookReturnCode code )
+{
+	return code == HOOK_HANDLED;
+}
+
+bool TestHandleArgument( Foo@ pFoo )
+{
+	return pFoo !is null;
+}
+
+funcdef HookReturnCode CountHook( int iValue );
+
+//Event used by the behavior checks. Hooks add the value they are called with to their counter.
+CScriptEvent@ g_CountEvent = g_EventManager.CreateEvent( "BehaviorCount", "CountHook" );
+
+int g_iHookCalls = 0;
+int g_iOtherHookCalls = 0;
+
+HookReturnCode CountingHook( int iValue )
+{
+	g_iHookCalls += iValue;
+	
+	return HOOK_CONTINUE;
+}
+
+HookReturnCode OtherCountingHook( int iValue )
+{
+	g_iOtherHookCalls += iValue;
+	
+	return HOOK_CONTINUE;
+}
+
+//Hooks and calls an event created by this script.
+bool TestScriptEvent()
+{
+	g_iHookCalls = 0;
+	
+	if( !g_CountEvent.Hook( CountingHook ) )
+		return false;
+	
+	g_CountEvent.Call( 2 );
+	
+	g_CountEvent.Unhook( CountingHook );
+	
+	return g_iHookCalls == 2;
+}
+
+int AddOne( int iValue )
+{
+	return iValue + 1;
+}
+
+int g_iArgumentSum = 0;
+
+void SumEight( int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8 )
+{
+	g_iArgumentSum = i1 + i2 + i3 + i4 + i5 + i6 + i7 + i8;
+}
+
+void SumNine( int i1, int i2, int i3, int i4, int i5, int i6, int i7, int i8, int i9 )
+{
+	g_iArgumentSum = i1 + i2 + i3 + i4 + i5 + i6 + i7 + i8 + i9;
+}
+
 class Lifetime
 {
 	Lifetime()
@@ -71,6 +170,10 @@ Lifetime@ GetLifetime()
 	return @Lifetime();
 }
 
+void TakeLifetime( Lifetime@ pLifetime )
+{
+}
+
 void PrintReflection()
 {
 	/*
@@ -0,0 +1,232 @@
+#include <cassert>
+#include <utility>
+
+#include "util/ASLogging.h"
+#include "util/ASPlatform.h"
+
+#include "CASContextPool.h"
+
+namespace
+{
+std::atomic<uint64_t> g_uiNextPoolID{ 1 };
+
+/**
+*	Caches the free list of the last pool that the calling thread used, so requests don't need to look it up.
+*	Stored as plain values, since thread-local storage on some compilers can't be dynamically initialized.
+*/
+AS_THREAD_LOCAL uint64_t g_uiCachedPoolID = 0;
+AS_THREAD_LOCAL std::vector<asIScriptContext*>* g_pCachedFreeList = nullptr;
+}
+
+CASContextPool::CASContextPool( asIScriptEngine& engine, const size_t uiMaxFreeContexts )
+	: m_Engine( engine )
+	, m_uiPoolID( g_uiNextPoolID++ )
+	, m_uiMaxFreeContexts( uiMaxFreeContexts )
+{
+}
+
+CASContextPool::~CASContextPool()
+{
+	Uninstall();
+	Clear();
+}
+
+void CASContextPool::Install()
+{
+	const auto result = m_Engine.SetContextCallbacks( &CASContextPool::RequestContextCallback, &CASContextPool::ReturnContextCallback, this );
+
+	m_bInstalled = result >= 0;
+
+	if( !m_bInstalled )
+		as::log->error( "CASContextPool::Install: Couldn't set context callbacks ({})", result );
+}
+
+void CASContextPool::Uninstall()
+{
+	if( !m_bInstalled )
+		return;
+
+	m_Engine.SetContextCallbacks( nullptr, nullptr, nullptr );
+
+	m_bInstalled = false;
+}
+
+bool CASContextPool::VerifyInstalled()
+{
+	if( !m_bInstalled )
+		return false;
+
+	const auto uiRequestCount = m_uiHits + m_uiMisses;
+
+	auto pContext = m_Engine.RequestContext();
+
+	//If no context could be created, there's no telling who handled the request. Assume nothing changed.
+	if( !pContext )
+		return m_bInstalled;
+
+	m_bInstalled = m_uiHits + m_uiMisses != uiRequestCount;
+
+	m_Engine.ReturnContext( pContext );
+
+	return m_bInstalled;
+}
+
+void CASContextPool::Prewarm( const size_t uiCount )
+{
+	auto& freeList = GetFreeList();
+
+	const size_t uiTarget = uiCount < m_uiMaxFreeContexts ? uiCount : m_uiMaxFreeContexts;
+
+	while( freeList.size() < uiTarget )
+	{
+		auto pContext = CreateContext();
+
+		if( !pContext )
+			break;
+
+		freeList.push_back( pContext );
+	}
+}
+
+asIScriptContext* CASContextPool::RequestContext()
+{
+	auto& freeList = GetFreeList();
+
+	asIScriptContext* pContext;
+
+	if( !freeList.empty() )
+	{
+		pContext = freeList.back();
+		freeList.pop_back();
+
+		++m_uiHits;
+	}
+	else
+	{
+		pContext = CreateContext();
+
+		if( !pContext )
+			return nullptr;
+
+		++m_uiMisses;
+	}
+
+	const auto uiInUse = ++m_uiInUse;
+
+	auto uiPeak = m_uiPeakInUse.load( std::memory_order_relaxed );
+
+	while( uiInUse > uiPeak && !m_uiPeakInUse.compare_exchange_weak( uiPeak, uiInUse, std::memory_order_relaxed ) )
+	{
+	}
+
+	return pContext;
+}
+
+void CASContextPool::ReturnContext( asIScriptContext* pContext )
+{
+	if( !pContext )
+		return;
+
+	--m_uiInUse;
+
+	pContext->Unprepare();
+
+	auto& freeList = GetFreeList();
+
+	if( freeList.size() < m_uiMaxFreeContexts )
+	{
+		freeList.push_back( pContext );
+	}
+	else
+	{
+		++m_uiDiscarded;
+		pContext->Release();
+	}
+}
+
+void CASContextPool::Clear()
+{
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	for( auto& freeList : m_FreeLists )
+	{
+		for( auto pContext : *freeList.second )
+		{
+			pContext->Release();
+		}
+
+		freeList.second->clear();
+	}
+}
+
+CASContextPoolStats CASContextPool::GetStats() const
+{
+	CASContextPoolStats stats;
+
+	stats.uiHits = m_uiHits;
+	stats.uiMisses = m_uiMisses;
+	stats.uiDiscarded = m_uiDiscarded;
+	stats.uiInUse = m_uiInUse;
+	stats.uiPeakInUse = m_uiPeakInUse;
+
+	return stats;
+}
+
+void CASContextPool::ResetStats()
+{
+	m_uiHits = 0;
+	m_uiMisses = 0;
+	m_uiDiscarded = 0;
+	m_uiPeakInUse = m_uiInUse.load();
+}
+
+CASContextPool::FreeList_t& CASContextPool::GetFreeList()
+{
+	if( g_uiCachedPoolID == m_uiPoolID )
+		return *g_pCachedFreeList;
+
+	std::lock_guard<std::mutex> lock( m_Mutex );
+
+	auto& freeList = m_FreeLists[ std::this_thread::get_id() ];
+
+	if( !freeList )
+	{
+		freeList.reset( new FreeList_t() );
+		freeList->reserve( m_uiMaxFreeContexts );
+	}
+
+	g_uiCachedPoolID = m_uiPoolID;
+	g_pCachedFreeList = freeList.get();
+
+	return *freeList;
+}
+
+asIScriptContext* CASContextPool::CreateContext()
+{
+	auto pContext = m_Engine.CreateContext();
+
+	if( !pContext )
+	{
+		as::log->error( "CASContextPool: Couldn't create context" );
+		return nullptr;
+	}
+
+	if( m_ContextCreatedCallback )
+		m_ContextCreatedCallback( *pContext );
+
+	return pContext;
+}
+
+asIScriptContext* CASContextPool::RequestContextCallback( asIScriptEngine*, void* pParam )
+{
+	assert( pParam );
+
+	return reinterpret_cast<CASContextPool*>( pParam )->RequestContext();
+}
+
+void CASContextPool::ReturnContextCallback( asIScriptEngine*, asIScriptContext* pContext, void* pParam )
+{
+	assert( pParam );
+
+	reinterpret_cast<CASContextPool*>( pParam )->ReturnContext( pContext );
+}
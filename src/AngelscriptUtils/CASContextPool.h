@@ -0,0 +1,214 @@
+#ifndef ANGELSCRIPT_CASCONTEXTPOOL_H
+#define ANGELSCRIPT_CASCONTEXTPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <angelscript.h>
+
+/**
+*	@addtogroup ASManager
+*
+*	@{
+*/
+
+/**
+*	Context pool statistics.
+*/
+struct CASContextPoolStats final
+{
+	/**
+	*	Number of requests that were served from a free list.
+	*/
+	uint64_t uiHits = 0;
+
+	/**
+	*	Number of requests that had to create a new context.
+	*/
+	uint64_t uiMisses = 0;
+
+	/**
+	*	Number of returned contexts that were released because the free list was full.
+	*/
+	uint64_t uiDiscarded = 0;
+
+	/**
+	*	Number of contexts that are currently in use.
+	*/
+	uint32_t uiInUse = 0;
+
+	/**
+	*	Highest number of contexts that were in use at the same time.
+	*/
+	uint32_t uiPeakInUse = 0;
+};
+
+/**
+*	Pool of script contexts that is installed in the engine using asIScriptEngine::SetContextCallbacks.
+*	All calls to asIScriptEngine::RequestContext and asIScriptEngine::ReturnContext go through the pool,
+*	including those made by CASOwningContext, as::Call and event callers.
+*
+*	Each thread has its own free list, so requesting and returning contexts does not take a lock.
+*	The number of free contexts kept per thread is capped; contexts returned to a full list are released.
+*/
+class CASContextPool final
+{
+public:
+	/**
+	*	Default maximum number of free contexts that are kept per thread.
+	*/
+	static const size_t DEFAULT_MAX_FREE_CONTEXTS = 16;
+
+	/**
+	*	Called when a new context has been created, before it is handed out. Can be used to set up the context, e.g. to set a result handler.
+	*/
+	typedef std::function<void( asIScriptContext& context )> ContextCreatedCallback_t;
+
+public:
+	/**
+	*	Constructor.
+	*	@param engine Script engine to create contexts with.
+	*	@param uiMaxFreeContexts Maximum number of free contexts that are kept per thread.
+	*/
+	CASContextPool( asIScriptEngine& engine, const size_t uiMaxFreeContexts = DEFAULT_MAX_FREE_CONTEXTS );
+
+	/**
+	*	Destructor. Uninstalls the pool if it is installed, and releases all free contexts.
+	*/
+	~CASContextPool();
+
+	/**
+	*	@return The script engine.
+	*/
+	asIScriptEngine& GetEngine() { return m_Engine; }
+
+	/**
+	*	@return Maximum number of free contexts that are kept per thread.
+	*/
+	size_t GetMaxFreeContexts() const { return m_uiMaxFreeContexts; }
+
+	/**
+	*	Sets the maximum number of free contexts that are kept per thread. Lists that are already larger are trimmed as contexts are returned.
+	*/
+	void SetMaxFreeContexts( const size_t uiMaxFreeContexts )
+	{
+		m_uiMaxFreeContexts = uiMaxFreeContexts;
+	}
+
+	/**
+	*	Sets the callback that is called for new contexts. Should be set before the pool is used.
+	*/
+	void SetContextCreatedCallback( ContextCreatedCallback_t callback )
+	{
+		m_ContextCreatedCallback = std::move( callback );
+	}
+
+	/**
+	*	@return Whether this pool is installed in the engine.
+	*/
+	bool IsInstalled() const { return m_bInstalled; }
+
+	/**
+	*	Installs this pool in the engine. Replaces any context callbacks that were set before.
+	*/
+	void Install();
+
+	/**
+	*	Removes this pool from the engine. Contexts that are in use are released when they are returned.
+	*/
+	void Uninstall();
+
+	/**
+	*	Checks whether this pool is still installed, by requesting a context from the engine and checking whether this pool handed it out.
+	*	The engine has no way to query its context callbacks, so this is how callbacks set by the application after Install are detected.
+	*	If they were replaced, the pool is marked as not installed, so Uninstall leaves the application's callbacks alone.
+	*	Must not be called while other threads are using the engine.
+	*	@return Whether this pool is installed.
+	*/
+	bool VerifyInstalled();
+
+	/**
+	*	Creates contexts for the calling thread, up to the given number of free contexts.
+	*	@param uiCount Number of free contexts to have. Limited by the maximum number of free contexts.
+	*/
+	void Prewarm( const size_t uiCount );
+
+	/**
+	*	Gets a context. Uses a free context for the calling thread if there is one, otherwise creates a new one.
+	*	@return Context, or null if the context could not be created.
+	*/
+	asIScriptContext* RequestContext();
+
+	/**
+	*	Returns a context. The context is unprepared and added to the calling thread's free list, or released if the list is full.
+	*	@param pContext Context to return.
+	*/
+	void ReturnContext( asIScriptContext* pContext );
+
+	/**
+	*	Releases all free contexts. Must not be called while other threads are using the pool.
+	*/
+	void Clear();
+
+	/**
+	*	@return Current statistics.
+	*/
+	CASContextPoolStats GetStats() const;
+
+	/**
+	*	Resets hit, miss and discard counters. The peak is reset to the current number of contexts in use.
+	*/
+	void ResetStats();
+
+private:
+	typedef std::vector<asIScriptContext*> FreeList_t;
+
+	/**
+	*	@return The calling thread's free list.
+	*/
+	FreeList_t& GetFreeList();
+
+	asIScriptContext* CreateContext();
+
+	static asIScriptContext* RequestContextCallback( asIScriptEngine* pEngine, void* pParam );
+
+	static void ReturnContextCallback( asIScriptEngine* pEngine, asIScriptContext* pContext, void* pParam );
+
+private:
+	asIScriptEngine& m_Engine;
+
+	//Unique among all pools created by this process, used to validate the thread-local free list cache.
+	const uint64_t m_uiPoolID;
+
+	size_t m_uiMaxFreeContexts;
+
+	ContextCreatedCallback_t m_ContextCreatedCallback;
+
+	bool m_bInstalled = false;
+
+	//Guards m_FreeLists. Only used the first time a thread uses this pool.
+	std::mutex m_Mutex;
+
+	std::unordered_map<std::thread::id, std::unique_ptr<FreeList_t>> m_FreeLists;
+
+	std::atomic<uint64_t> m_uiHits{ 0 };
+	std::atomic<uint64_t> m_uiMisses{ 0 };
+	std::atomic<uint64_t> m_uiDiscarded{ 0 };
+	std::atomic<uint32_t> m_uiInUse{ 0 };
+	std::atomic<uint32_t> m_uiPeakInUse{ 0 };
+
+private:
+	CASContextPool( const CASContextPool& ) = delete;
+	CASContextPool& operator=( const CASContextPool& ) = delete;
+};
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASCONTEXTPOOL_H
@@ -153,7 +153,7 @@ void CASLoggingContextResultHandler::LogCurrentFunction( asIScriptContext& conte
 
 	as::GetCallerInfo( info, &context );
 
-	auto pCurrentFunc = context.GetFunction( context.GetCallstackSize() - 1 );
+	auto pCurrentFunc = as::GetEntryFunction( context );
 
 	if( pCurrentFunc )
 	{
@@ -14,6 +14,7 @@
 #include "IASInitializer.h"
 
 #include "CASManager.h"
+#include "CASModule.h"
 
 #include "std_make_unique.h"
 
@@ -95,16 +96,30 @@ bool CASManager::Initialize( IASInitializer& initializer )
 
 	InitEndCaller initEndCaller( initializer );
 
-	initializer.OnInitBegin();
-
 	//Set the cleanup callback for the result handler.
 	m_pScriptEngine->SetContextUserDataCleanupCallback( as::FreeContextResultHandler, ASUTILS_CONTEXT_RESULTHANDLER_USERDATA_ID );
 
+	//Removes freed functions from the module cache used by event lookups.
+	m_pScriptEngine->SetFunctionUserDataCleanupCallback( &::FreeCachedFunctionModule, ASUTILS_FUNCTION_MODULE_USERDATA_ID );
+
+	//Installed before OnInitBegin so applications can still set their own context callbacks.
+	m_ContextPool = std::make_unique<CASContextPool>( *m_pScriptEngine );
+
+	initializer.ConfigureContextPool( *m_ContextPool );
+
+	m_ContextPool->Install();
+
+	initializer.OnInitBegin();
+
+	//Don't prewarm contexts that will never be used if the application replaced the pool's callbacks.
+	if( m_ContextPool->VerifyInstalled() )
+		m_ContextPool->Prewarm( initializer.GetPrewarmedContextCount() );
+
 	const bool bUseEventManager = initializer.UseEventManager();
 
 	if( bUseEventManager )
 	{
-		m_EventManager = std::make_unique<CASEventManager>( *m_pScriptEngine, initializer.GetEventNamespace() );
+		m_EventManager = std::make_unique<CASEventManager>( *m_pScriptEngine, initializer.GetEventNamespace(), initializer.GetDeferredEventQueueSize() );
 	}
 
 	m_ModuleManager = std::make_unique<CASModuleManager>( *m_pScriptEngine, m_EventManager );
@@ -168,6 +183,9 @@ void CASManager::Shutdown()
 		m_ModuleManager.reset();
 	}
 
+	//Release all pooled contexts while the engine is still alive.
+	m_ContextPool.reset();
+
 	//Let it go.
 	m_pScriptEngine->ShutDownAndRelease();
 	m_pScriptEngine = nullptr;
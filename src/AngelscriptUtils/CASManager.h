@@ -5,6 +5,7 @@
 
 #include "util/ASPlatform.h"
 
+#include "CASContextPool.h"
 #include "CASModuleManager.h"
 #include "event/CASEventManager.h"
 
@@ -64,6 +65,11 @@ public:
 	*/
 	asIScriptEngine* GetEngine() { return m_pScriptEngine; }
 
+	/**
+	*	@return The context pool. Only valid while the manager is initialized.
+	*/
+	CASContextPool* GetContextPool() { return m_ContextPool.get(); }
+
 	/**
 	*	@return The module manager.
 	*/
@@ -99,6 +105,8 @@ private:
 
 	asIScriptEngine* m_pScriptEngine = nullptr;
 
+	std::unique_ptr<CASContextPool> m_ContextPool;
+
 	std::unique_ptr<CASModuleManager> m_ModuleManager;
 	std::shared_ptr<CASEventManager> m_EventManager;
 
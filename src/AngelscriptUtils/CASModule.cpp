@@ -4,6 +4,8 @@
 
 #include "ScriptAPI/CASScheduler.h"
 
+#include "util/ASUtil.h"
+
 #include "CASModule.h"
 
 CASModule::CASModule( asIScriptModule* pModule, const CASModuleDescriptor& descriptor, IASModuleUserData* pUserData )
@@ -41,6 +43,14 @@ void CASModule::Discard()
 	//Clears out the functions that might be holding references to this module
 	m_pScheduler->ClearTimerList();
 
+	//Functions can outlive the module, so don't leave a dangling pointer in them. Freed functions have already removed themselves.
+	for( auto pFunction : m_CachedFunctions )
+	{
+		pFunction->SetUserData( nullptr, ASUTILS_FUNCTION_MODULE_USERDATA_ID );
+	}
+
+	m_CachedFunctions.clear();
+
 	if( m_pModule )
 	{
 		m_pModule->Discard();
@@ -48,6 +58,20 @@ void CASModule::Discard()
 	}
 }
 
+void CASModule::CacheInFunction( asIScriptFunction& function )
+{
+	assert( m_pModule );
+
+	function.SetUserData( this, ASUTILS_FUNCTION_MODULE_USERDATA_ID );
+
+	m_CachedFunctions.insert( &function );
+}
+
+void CASModule::UncacheFunction( asIScriptFunction& function )
+{
+	m_CachedFunctions.erase( &function );
+}
+
 const char* CASModule::GetModuleName() const
 {
 	assert( m_pModule );
@@ -79,7 +103,7 @@ CASModule* GetModuleFromScriptContext( asIScriptContext* pContext )
 {
 	assert( pContext );
 
-	auto pFunction = pContext->GetFunction( pContext->GetCallstackSize() - 1 );
+	auto pFunction = as::GetEntryFunction( *pContext );
 
 	if( !pFunction )
 		return nullptr;
@@ -91,10 +115,37 @@ asIScriptModule* GetScriptModuleFromScriptContext( asIScriptContext* pContext )
 {
 	assert( pContext );
 
-	auto pFunction = pContext->GetFunction( pContext->GetCallstackSize() - 1 );
+	auto pFunction = as::GetEntryFunction( *pContext );
 
 	if( !pFunction )
 		return nullptr;
 
 	return pFunction->GetModule();
 }
+
+CASModule* GetCallingModule( asIScriptContext& context )
+{
+	//The function that the call entered the script through. Calls nested on the same context have their own entry function.
+	auto pFunction = as::GetEntryFunction( context );
+
+	if( !pFunction )
+		return nullptr;
+
+	if( auto pModule = reinterpret_cast<CASModule*>( pFunction->GetUserData( ASUTILS_FUNCTION_MODULE_USERDATA_ID ) ) )
+		return pModule;
+
+	auto pModule = GetModuleFromScriptFunction( pFunction );
+
+	if( pModule )
+		pModule->CacheInFunction( *pFunction );
+
+	return pModule;
+}
+
+void FreeCachedFunctionModule( asIScriptFunction* pFunction )
+{
+	assert( pFunction );
+
+	if( auto pModule = reinterpret_cast<CASModule*>( pFunction->GetUserData( ASUTILS_FUNCTION_MODULE_USERDATA_ID ) ) )
+		pModule->UncacheFunction( *pFunction );
+}
@@ -1,7 +1,11 @@
 #ifndef ANGELSCRIPT_CASMODULE_H
 #define ANGELSCRIPT_CASMODULE_H
 
+#include <cstdint>
 #include <cstring>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "ASUtilsConfig.h"
 
@@ -9,6 +13,8 @@
 
 #include "CASModuleDescriptor.h"
 
+class asIScriptContext;
+class asIScriptFunction;
 class asIScriptModule;
 class CASScheduler;
 
@@ -83,6 +89,60 @@ public:
 	*/
 	CASScheduler* GetScheduler() { return m_pScheduler; }
 
+	/**
+	*	@return Whether this module's event hooks are called.
+	*/
+	bool AreHooksEnabled() const { return m_bHooksEnabled; }
+
+	/**
+	*	Sets whether this module's event hooks are called. Disabled hooks remain hooked, and are skipped when events are called.
+	*	Suspending and resuming hooks this way does not modify any event's hook list.
+	*/
+	void SetHooksEnabled( const bool bEnabled )
+	{
+		m_bHooksEnabled = bEnabled;
+	}
+
+	/**
+	*	@return Whether the event with the given index is visible to this module.
+	*	Only up to date if GetEventVisibilityGeneration matches the event manager's generation.
+	*	@see CASEventManager::UpdateEventVisibility
+	*/
+	bool IsEventVisible( const uint32_t uiIndex ) const
+	{
+		return uiIndex < m_VisibleEvents.size() && m_VisibleEvents[ uiIndex ];
+	}
+
+	/**
+	*	@return The event manager generation that the event visibility was built for. 0 if it was never built.
+	*/
+	uint32_t GetEventVisibilityGeneration() const { return m_uiEventVisibilityGeneration; }
+
+	/**
+	*	Sets which events are visible to this module.
+	*	@param visibleEvents One bit per event index.
+	*	@param uiGeneration Event manager generation that the visibility was built for.
+	*/
+	void SetEventVisibility( std::vector<bool>&& visibleEvents, const uint32_t uiGeneration )
+	{
+		m_VisibleEvents = std::move( visibleEvents );
+		m_uiEventVisibilityGeneration = uiGeneration;
+	}
+
+	/**
+	*	Caches this module in a function's user data, so it can be found without resolving the function's module again.
+	*	The cached entries are cleared when this module is discarded. Functions that are freed before that remove themselves, see FreeCachedFunctionModule.
+	*	@param function Function that belongs to this module.
+	*	@see GetCallingModule
+	*/
+	void CacheInFunction( asIScriptFunction& function );
+
+	/**
+	*	Forgets a function that this module was cached in. Called when the function is freed.
+	*	@param function Function to forget.
+	*/
+	void UncacheFunction( asIScriptFunction& function );
+
 	/**
 	*	@return User data associated with this module.
 	*/
@@ -108,6 +168,15 @@ private:
 
 	IASModuleUserData* m_pUserData = nullptr;
 
+	bool m_bHooksEnabled = true;
+
+	std::vector<bool> m_VisibleEvents;
+
+	uint32_t m_uiEventVisibilityGeneration = 0;
+
+	//Functions that this module is cached in. Not referenced; functions remove themselves when they are freed.
+	std::unordered_set<asIScriptFunction*> m_CachedFunctions;
+
 private:
 	CASModule( const CASModule& ) = delete;
 	CASModule& operator=( const CASModule& ) = delete;
@@ -129,18 +198,33 @@ CASModule* GetModuleFromScriptFunction( const asIScriptFunction* pFunction );
 
 /**
 *	Gets a module from a script context.
-*	@param pContext Script context to retrieve the module from. Uses the function currently being executed.
+*	@param pContext Script context to retrieve the module from. Uses the entry function of the current call, see as::GetEntryFunction.
 *	@return The module, or null if it couldn't be retrieved.
 */
 CASModule* GetModuleFromScriptContext( asIScriptContext* pContext );
 
 /**
 *	Gets a script module from a script context.
-*	@param pContext Script context to retrieve the module from. Uses the function currently being executed.
+*	@param pContext Script context to retrieve the module from. Uses the entry function of the current call, see as::GetEntryFunction.
 *	@return The script module, or null if it couldn't be retrieved.
 */
 asIScriptModule* GetScriptModuleFromScriptContext( asIScriptContext* pContext );
 
+/**
+*	Gets the module of the entry function of the call that is calling into the application, see as::GetEntryFunction.
+*	The module is cached in the entry function's user data, so repeated calls through the same entry function don't resolve the module again.
+*	@param context Context that is executing a script.
+*	@return The module, or null if it couldn't be retrieved.
+*/
+CASModule* GetCallingModule( asIScriptContext& context );
+
+/**
+*	Callback used to remove a function from its module's cache when the function is freed.
+*	Temporary functions, e.g. those created by asIScriptModule::CompileFunction, can be freed long before their module is discarded.
+*	Set this after creating the engine.
+*/
+void FreeCachedFunctionModule( asIScriptFunction* pFunction );
+
 /**
 *	Less function for modules.
 *	@param pLHS Left hand module.
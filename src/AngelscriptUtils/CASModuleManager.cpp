@@ -278,6 +278,9 @@ bool CASModuleManager::AddModule( CASModule* pModule )
 
 	std::stable_sort( m_Modules.begin(), m_Modules.end(), ModuleLess );
 
+	if( m_EventManager )
+		m_EventManager->UpdateEventVisibility( *pModule );
+
 	return true;
 }
 
@@ -321,6 +324,45 @@ void CASModuleManager::RemoveModule( const char* const pszModuleName )
 	m_Modules.erase( it );
 }
 
+void CASModuleManager::RemoveModules( const std::vector<CASModule*>& modules )
+{
+	Modules_t removedModules;
+
+	removedModules.reserve( modules.size() );
+
+	for( auto pModule : modules )
+	{
+		if( pModule &&
+			std::find( m_Modules.begin(), m_Modules.end(), pModule ) != m_Modules.end() &&
+			std::find( removedModules.begin(), removedModules.end(), pModule ) == removedModules.end() )
+		{
+			removedModules.push_back( pModule );
+		}
+	}
+
+	if( removedModules.empty() )
+		return;
+
+	if( m_EventManager )
+	{
+		//Unhook the functions that the modules registered.
+		m_EventManager->UnhookModuleFunctions( removedModules );
+	}
+
+	auto it = std::remove_if( m_Modules.begin(), m_Modules.end(), [ & ]( CASModule* pModule )
+	{
+		return std::find( removedModules.begin(), removedModules.end(), pModule ) != removedModules.end();
+	} );
+
+	m_Modules.erase( it, m_Modules.end() );
+
+	for( auto pModule : removedModules )
+	{
+		pModule->Discard();
+		pModule->Release();
+	}
+}
+
 void CASModuleManager::Clear()
 {
 	for( auto pModule : m_Modules )
@@ -154,6 +154,13 @@ public:
 	*/
 	void RemoveModule( const char* const pszModuleName );
 
+	/**
+	*	Removes a list of modules. Their functions are unhooked from events in a single pass.
+	*	@param modules Modules to remove. Modules that are not managed by this manager are ignored.
+	*	@see RemoveModule( CASModule* pModule )
+	*/
+	void RemoveModules( const std::vector<CASModule*>& modules );
+
 	/**
 	*	Removes all modules and descriptors.
 	*/
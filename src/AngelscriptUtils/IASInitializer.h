@@ -1,6 +1,8 @@
 #ifndef ANGELSCRIPT_IASINITIALIZER_H
 #define ANGELSCRIPT_IASINITIALIZER_H
 
+#include <cstddef>
+
 #include <angelscript.h>
 
 #include "util/ASPlatform.h"
@@ -11,6 +13,7 @@
 *	@{
 */
 
+class CASContextPool;
 class CASManager;
 class CASEventManager;
 
@@ -52,6 +55,25 @@ public:
 	*/
 	virtual const char* GetEventNamespace() { return "Events"; }
 
+	/**
+	*	Gets the maximum number of deferred events that can be queued in the event manager. Default 1024.
+	*/
+	virtual asUINT GetDeferredEventQueueSize() { return 1024; }
+
+	/**
+	*	Called after the context pool has been created, before it is installed.
+	*	Can be used to change the pool's settings, or to set a callback that sets up new contexts.
+	*	Applications that set their own context callbacks in OnInitBegin replace the pool. The pool detects this, and leaves their callbacks in place on shutdown.
+	*	@param pool Context pool.
+	*/
+	virtual void ConfigureContextPool( CASContextPool& pool );
+
+	/**
+	*	Gets the number of contexts that the context pool creates for the main thread on startup. Default 4.
+	*	Not used if the pool was replaced.
+	*/
+	virtual size_t GetPrewarmedContextCount() { return 4; }
+
 	/**
 	*	Should register the core API, including the following types:
 	*	string
@@ -91,6 +113,10 @@ inline bool IASInitializer::GetMessageCallback( asSFuncPtr&, void*&, asDWORD& )
 	return false;
 }
 
+inline void IASInitializer::ConfigureContextPool( CASContextPool& )
+{
+}
+
 inline bool IASInitializer::AddEvents( CASManager&, CASEventManager& )
 {
 	return true;
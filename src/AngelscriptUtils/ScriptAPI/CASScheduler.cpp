@@ -20,11 +20,7 @@ void CASScheduler::CScheduledFunction::Remove( asIScriptEngine& engine )
 
 	m_bRemoved = true;
 
-	if( m_pArguments )
-	{
-		delete m_pArguments;
-		m_pArguments = nullptr;
-	}
+	m_Arguments.Clear();
 
 	if( m_pThis )
 	{
@@ -165,9 +161,9 @@ void CASScheduler::SetInterval( void* pThis, int iTypeId, const std::string& szF
 
 	CScheduledFunction* pFunc = nullptr;
 
-	CASArguments* pArgs = new CASArguments();
+	CASArguments args;
 
-	if( ( bSuccess = pArgs->SetArguments( arguments, uiStartIndex ) ) != false )
+	if( ( bSuccess = args.SetArguments( arguments, uiStartIndex ) ) != false )
 	{
 		if( pThis && iTypeId & asTYPEID_OBJHANDLE )
 			pThis = *reinterpret_cast<void**>( pThis );
@@ -182,7 +178,7 @@ void CASScheduler::SetInterval( void* pThis, int iTypeId, const std::string& szF
 			{
 				if( pType->GetFlags() & asOBJ_REF )
 				{
-					pFunction = as::FindFunction( *pEngine, as::CASMethodIterator( *pType ), szFunctionName, *pArgs );
+					pFunction = as::FindFunction( *pEngine, as::CASMethodIterator( *pType ), szFunctionName, args );
 				}
 				else
 				{
@@ -197,7 +193,7 @@ void CASScheduler::SetInterval( void* pThis, int iTypeId, const std::string& szF
 		}
 		else
 		{
-			pFunction = as::FindFunction( *pEngine, as::CASFunctionIterator( *m_OwningModule.GetModule() ), szFunctionName, *pArgs );
+			pFunction = as::FindFunction( *pEngine, as::CASFunctionIterator( *m_OwningModule.GetModule() ), szFunctionName, args );
 		}
 
 		if( pFunction )
@@ -211,7 +207,7 @@ void CASScheduler::SetInterval( void* pThis, int iTypeId, const std::string& szF
 				iRepeatCount,
 				pThis,
 				iTypeId,
-				pArgs
+				std::move( args )
 				);
 
 			if( pThis )
@@ -229,7 +225,6 @@ void CASScheduler::SetInterval( void* pThis, int iTypeId, const std::string& szF
 		}
 		else
 		{
-			delete pArgs;
 			as::log->critical( "Error: CScheduler::SetInterval: could not add function '{}', function not found", szFunctionName );
 			bSuccess = false;
 		}
@@ -334,13 +329,13 @@ void CASScheduler::Think( const float flCurrentTime )
 					{
 						CASMethod method( *pFunction, context, pThis );
 
-						bSuccess = method.CallArgs( CallFlag::NONE, *pNext->GetArguments() );
+						bSuccess = method.CallArgs( CallFlag::NONE, pNext->GetArguments() );
 					}
 					else
 					{
 						CASFunction function( *pFunction, context );
 
-						bSuccess = function.CallArgs( CallFlag::NONE, *pNext->GetArguments() );
+						bSuccess = function.CallArgs( CallFlag::NONE, pNext->GetArguments() );
 					}
 
 					if( !bSuccess )
@@ -3,13 +3,15 @@
 
 #include <cassert>
 #include <string>
+#include <utility>
 
 #include <angelscript.h>
 
 #include "AngelscriptUtils/util/CASBaseClass.h"
 
+#include "AngelscriptUtils/wrapper/CASArguments.h"
+
 class CASModule;
-class CASArguments;
 
 /**
 *	Schedules functions for execution at a set time.
@@ -36,12 +38,12 @@ public:
 		*	@param iRepeatCount Number of times to call the function, or infinite if REPEAT_INF_TIMES is given.
 		*	@param pThis This pointer. Can be null.
 		*	@param iTypeId This pointer type id.
-		*	@param pArguments Function arguments.
+		*	@param arguments Function arguments. Moved into this function, which owns the only copy for its lifetime.
 		*	@param pNext Next function in the list.
 		*/
 		CScheduledFunction( asIScriptFunction* const pFunction,
 			const float flNextCallTime, const float flRepeatTime, const int iRepeatCount, 
-			void* const pThis, const int iTypeId, CASArguments* pArguments, CScheduledFunction* const pNext = nullptr )
+			void* const pThis, const int iTypeId, CASArguments&& arguments, CScheduledFunction* const pNext = nullptr )
 			: CASRefCountedBaseClass()
 			, m_pFunction( pFunction )
 			, m_flNextCallTime( flNextCallTime )
@@ -49,7 +51,7 @@ public:
 			, m_iRepeatCount( iRepeatCount )
 			, m_pThis( pThis )
 			, m_iTypeId( iTypeId )
-			, m_pArguments( pArguments )
+			, m_Arguments( std::move( arguments ) )
 			, m_pNext( pNext )
 		{
 			pFunction->AddRef();
@@ -180,9 +182,9 @@ public:
 		int GetTypeId() const { return m_iTypeId; }
 
 		/**
-		*	@return The list of arguments.
+		*	@return The list of arguments. Calls use these directly, so they are not copied per call.
 		*/
-		CASArguments* GetArguments() const { return m_pArguments; }
+		const CASArguments& GetArguments() const { return m_Arguments; }
 
 	private:
 		/**
@@ -199,7 +201,7 @@ public:
 		void*				m_pThis;
 		const int			m_iTypeId;
 
-		CASArguments*		m_pArguments;
+		CASArguments		m_Arguments;
 
 		CScheduledFunction*	m_pNext;
 
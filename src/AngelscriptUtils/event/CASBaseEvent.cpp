@@ -1,5 +1,5 @@
-#include <algorithm>
 #include <cassert>
+#include <utility>
 
 #include "AngelscriptUtils/util/ASLogging.h"
 #include "AngelscriptUtils/util/ASUtil.h"
@@ -10,6 +10,7 @@
 
 CASBaseEvent::CASBaseEvent( const asDWORD accessMask )
 	: m_AccessMask( accessMask )
+	, m_Hooks( new CASEventHookList(), true )
 {
 	assert( accessMask != 0 );
 }
@@ -19,50 +20,39 @@ CASBaseEvent::~CASBaseEvent()
 	RemoveAllFunctions();
 }
 
-size_t CASBaseEvent::GetFunctionCount() const
-{
-	return m_Functions.size();
-}
-
 asIScriptFunction* CASBaseEvent::GetFunctionByIndex( const size_t uiIndex ) const
 {
-	assert( uiIndex < m_Functions.size() );
+	assert( uiIndex < m_Hooks->GetHookCount() );
 
-	return m_Functions[ uiIndex ];
+	return m_Hooks->GetHook( uiIndex ).GetFunction();
 }
 
 bool CASBaseEvent::AddFunction( asIScriptFunction* pFunction )
 {
 	assert( pFunction );
 
-	//Don't add functions while this event is being invoked.
-	if( IsTriggering() )
-	{
-		as::CASCallerInfo info;
-
-		as::GetCallerInfo( info );
-
-		as::log->critical( "CBaseEvent::AddFunction: {}({}, {}): Cannot add function while invoking event!", info.pszSection, info.iLine, info.iColumn );
+	if( !pFunction )
 		return false;
-	}
 
-	if( !pFunction )
+	if( !GetWritableHookList().Add( pFunction ) )
 		return false;
 
-	if( std::find( m_Functions.begin(), m_Functions.end(), pFunction ) != m_Functions.end() )
-		return true;
+	NotifyHooksChanged( pFunction );
+
+	return true;
+}
 
-	m_Functions.push_back( pFunction );
+bool CASBaseEvent::AddFunction( asIScriptFunction* pFunction, const int iKey )
+{
+	assert( pFunction );
 
-	pFunction->AddRef();
+	if( !pFunction )
+		return false;
 
-	std::stable_sort( m_Functions.begin(), m_Functions.end(), []( const asIScriptFunction* pLHS, const asIScriptFunction* pRHS )
-	{
-		auto pLHSModule = GetModuleFromScriptFunction( pLHS );
-		auto pRHSModule = GetModuleFromScriptFunction( pRHS );
+	if( !GetWritableHookList().Add( pFunction, iKey ) )
+		return false;
 
-		return ModuleLess( pLHSModule, pRHSModule );
-	} );
+	NotifyHooksChanged( pFunction );
 
 	return true;
 }
@@ -84,31 +74,60 @@ bool CASBaseEvent::Hook( void* pValue, const int iTypeId )
 	return AddFunction( pFunction );
 }
 
+bool CASBaseEvent::HookKeyed( void* pValue, const int iTypeId, const int iKey )
+{
+	assert( pValue );
+
+	if( !pValue )
+		return false;
+
+	asIScriptFunction* pFunction = nullptr;
+
+	if( !ValidateHookFunction( iTypeId, pValue, "HookFunction", pFunction ) )
+	{
+		return false;
+	}
+
+	return AddFunction( pFunction, iKey );
+}
+
 void CASBaseEvent::RemoveFunction( asIScriptFunction* pFunction )
 {
 	if( !pFunction )
 		return;
 
-	auto it = std::find( m_Functions.begin(), m_Functions.end(), pFunction );
+	//If currently triggering, calls in progress keep using the published list.
+	if( GetWritableHookList().Remove( pFunction ) )
+		NotifyHooksChanged( pFunction );
+}
 
-	if( it == m_Functions.end() )
+void CASBaseEvent::RemoveFunction( asIScriptFunction* pFunction, const int iKey )
+{
+	if( !pFunction )
 		return;
 
-	( *it )->Release();
+	if( GetWritableHookList().Remove( pFunction, iKey ) )
+		NotifyHooksChanged( pFunction );
+}
 
-	if( IsTriggering() )
-	{
-		//Currently triggering, mark as removed.
-		*it = nullptr;
-	}
-	else
+void CASBaseEvent::Unhook( void* pValue, const int iTypeId )
+{
+	assert( pValue );
+
+	if( !pValue )
+		return;
+
+	asIScriptFunction* pFunction = nullptr;
+
+	if( !ValidateHookFunction( iTypeId, pValue, "UnhookFunction", pFunction ) )
 	{
-		//Remove now.
-		m_Functions.erase( it );
+		return;
 	}
+
+	RemoveFunction( pFunction );
 }
 
-void CASBaseEvent::Unhook( void* pValue, const int iTypeId )
+void CASBaseEvent::UnhookKeyed( void* pValue, const int iTypeId, const int iKey )
 {
 	assert( pValue );
 
@@ -122,7 +141,7 @@ void CASBaseEvent::Unhook( void* pValue, const int iTypeId )
 		return;
 	}
 
-	RemoveFunction( pFunction );
+	RemoveFunction( pFunction, iKey );
 }
 
 void CASBaseEvent::RemoveFunctionsOfModule( CASModule* pModule )
@@ -145,27 +164,44 @@ void CASBaseEvent::RemoveFunctionsOfModule( CASModule* pModule )
 	if( !pModule )
 		return;
 
-	//These functions might be null in some edge cases due to hooks being removed in event calls.
-	//Fixed version provided by HoraceWeebler - Solokiller
-	m_Functions.erase(
-		std::remove_if(
-			m_Functions.begin(),
-			m_Functions.end(),
-			[ &pModule ]( const asIScriptFunction* pFunction ) -> bool
-			{
-				if( !pFunction )
-					return true;
-				else if( pModule == GetModuleFromScriptFunction( pFunction ) )
-				{
-					pFunction->Release();
-					return true;
-				}
-				else
-					return false;
-			}
-		),
-		m_Functions.end()
-	);
+	GetWritableHookList().RemoveModule( pModule );
+
+	if( m_pHookObserver )
+		m_pHookObserver->OnModuleHooksChanged( *this, pModule );
+}
+
+void CASBaseEvent::RemoveFunctionsOfModules( const std::vector<CASModule*>& modules )
+{
+	//This method should never be called while in an event invocation.
+	if( IsTriggering() )
+	{
+		assert( !"CBaseEvent::RemoveFunctionsOfModules: Module hooks should not be removed while invoking events!" );
+
+		as::CASCallerInfo info;
+
+		as::GetCallerInfo( info );
+
+		as::log->critical( "CBaseEvent::RemoveFunctionsOfModules: {}({}, {}): Module hooks should not be removed while invoking events!", info.pszSection, info.iLine, info.iColumn );
+		return;
+	}
+
+	GetWritableHookList().RemoveModules( modules );
+
+	if( m_pHookObserver )
+	{
+		for( auto pModule : modules )
+		{
+			m_pHookObserver->OnModuleHooksChanged( *this, pModule );
+		}
+	}
+}
+
+bool CASBaseEvent::HasFunctionsOfModule( const CASModule* pModule ) const
+{
+	if( m_PendingHooks )
+		return m_PendingHooks->HasModuleHooks( pModule );
+
+	return m_Hooks->HasModuleHooks( pModule );
 }
 
 void CASBaseEvent::RemoveAllFunctions()
@@ -184,15 +220,67 @@ void CASBaseEvent::RemoveAllFunctions()
 		return;
 	}
 
-	for( auto pFunc : m_Functions )
+	auto& hooks = GetWritableHookList();
+
+	for( const auto& hook : hooks.GetHooks() )
+	{
+		if( hook.GetFunction()->GetDelegateFunction() )
+			hook.GetFunction()->Release();
+	}
+
+	//Copy the module ranges, clearing the list invalidates them.
+	hooks.UpdateIndices();
+
+	auto ranges = hooks.GetModuleRanges();
+
+	hooks.Clear();
+
+	if( m_pHookObserver )
 	{
-		if( pFunc->GetDelegateFunction() )
-			pFunc->Release();
+		for( const auto& range : ranges )
+		{
+			if( range.pModule )
+				m_pHookObserver->OnModuleHooksChanged( *this, range.pModule );
+		}
+	}
+}
 
-		pFunc->Release();
+ListenerID_t CASBaseEvent::AddListener( NativeEventListener_t listener, const as::ModulePriority_t priority )
+{
+	if( !listener )
+	{
+		as::log->error( "CBaseEvent::AddListener: Null listener passed!" );
+		return INVALID_LISTENER_ID;
 	}
 
-	m_Functions.clear();
+	const auto id = m_uiNextListenerID++;
+
+	//Listeners don't belong to a module, so the observer isn't notified.
+	GetWritableHookList().AddListener( id, priority, std::move( listener ) );
+
+	return id;
+}
+
+ListenerID_t CASBaseEvent::AddListener( NativeEventListenerFn pFunction, void* pUserData, const as::ModulePriority_t priority )
+{
+	if( !pFunction )
+	{
+		as::log->error( "CBaseEvent::AddListener: Null function passed!" );
+		return INVALID_LISTENER_ID;
+	}
+
+	return AddListener( [ = ]( CASBaseEvent& event, const CASEventArguments& args )
+	{
+		return pFunction( event, args, pUserData );
+	}, priority );
+}
+
+bool CASBaseEvent::RemoveListener( const ListenerID_t id )
+{
+	if( id == INVALID_LISTENER_ID )
+		return false;
+
+	return GetWritableHookList().RemoveListener( id );
 }
 
 bool CASBaseEvent::ValidateHookFunction( const int iTypeId, void* pObject, const char* const pszScope, asIScriptFunction*& pOutFunction ) const
@@ -295,29 +383,108 @@ void CASBaseEvent::DumpHookedFunctions( const char* const pszName ) const
 		}
 
 		const auto szFunctionName = as::FormatFunctionName( *pFunc );
-		as::log->info( "Module \"{}\", \"{}\"", pModule->GetName(), szFunctionName );
+		as::log->info( "Module \"{}\", \"{}\"{}", pModule->GetName(), szFunctionName, m_Hooks->GetHookState( uiIndex ).IsQuarantined() ? " (quarantined)" : "" );
+	}
+
+	for( const auto& listener : m_Hooks->GetListeners() )
+	{
+		as::log->info( "Native listener {}, priority {}", listener.id, listener.priority );
 	}
 
 	as::log->info( "End functions" );
 }
 
-void CASBaseEvent::ClearRemovedHooks()
+void CASBaseEvent::ResetStats()
+{
+	m_Stats.Reset();
+
+	m_Hooks->ResetStats();
+
+	//Hooks that were added during a call have not been published yet.
+	if( m_PendingHooks )
+		m_PendingHooks->ResetStats();
+}
+
+uint32_t CASBaseEvent::GetQuarantinedHookCount() const
+{
+	return static_cast<uint32_t>( m_Hooks->GetQuarantinedHookCount() );
+}
+
+void CASBaseEvent::ReleaseQuarantinedHooks()
+{
+	m_Hooks->ReleaseQuarantinedHooks();
+
+	if( m_PendingHooks )
+		m_PendingHooks->ReleaseQuarantinedHooks();
+}
+
+void CASBaseEvent::PublishPendingHooks()
 {
 	//Can happen when recursively triggering events.
-	if( IsTriggering() )
+	if( IsTriggering() || !m_PendingHooks )
 		return;
 
-	for( auto it = m_Functions.begin(); it != m_Functions.end(); )
+	//The states were copied when the pending list was created. Pick up the changes made by the calls since then.
+	m_PendingHooks->CopyHookStates( *m_Hooks );
+
+	m_Hooks = std::move( m_PendingHooks );
+}
+
+void CASBaseEvent::NotifyHooksChanged( const asIScriptFunction* pFunction )
+{
+	if( !m_pHookObserver )
+		return;
+
+	if( auto pModule = GetModuleFromScriptFunction( pFunction ) )
+		m_pHookObserver->OnModuleHooksChanged( *this, pModule );
+}
+
+CASEventHookList& CASBaseEvent::GetWritableHookList()
+{
+	if( IsTriggering() )
 	{
-		if( !( *it ) )
-		{
-			it = m_Functions.erase( it );
-		}
-		else
-		{
-			++it;
-		}
+		//Calls in progress are iterating the published list, so make a new version.
+		if( !m_PendingHooks )
+			m_PendingHooks.Set( new CASEventHookList( *m_Hooks ), true );
+
+		return *m_PendingHooks;
 	}
+
+	PublishPendingHooks();
+
+	//Someone else still holds a reference to the published list, copy on write.
+	if( m_Hooks->GetRefCount() > 1 )
+		m_Hooks.Set( new CASEventHookList( *m_Hooks ), true );
+
+	return *m_Hooks;
+}
+
+void RegisterScriptCEventStats( asIScriptEngine& engine )
+{
+	const char* const pszObjectName = "CEventStats";
+
+	engine.RegisterObjectType(
+		pszObjectName, 0, asOBJ_REF | asOBJ_NOCOUNT );
+
+	engine.RegisterObjectProperty(
+		pszObjectName, "const uint64 callCount",
+		asOFFSET( CASEventStats, uiCallCount ) );
+
+	engine.RegisterObjectProperty(
+		pszObjectName, "const uint64 handledCount",
+		asOFFSET( CASEventStats, uiHandledCount ) );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "double GetHandledRate() const",
+		asMETHOD( CASEventStats, GetHandledRate ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "double GetTotalTimeMs() const",
+		asMETHOD( CASEventStats, GetTotalTimeMs ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "double GetMaxTimeMs() const",
+		asMETHOD( CASEventStats, GetMaxTimeMs ), asCALL_THISCALL );
 }
 
 void RegisterScriptCBaseEvent( asIScriptEngine& engine )
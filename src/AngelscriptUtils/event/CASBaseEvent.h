@@ -1,14 +1,20 @@
 #ifndef ANGELSCRIPT_CASBASEEVENT_H
 #define ANGELSCRIPT_CASBASEEVENT_H
 
+#include <cstdint>
 #include <vector>
 
 #include <angelscript.h>
 
 #include "AngelscriptUtils/util/ASUtil.h"
+#include "AngelscriptUtils/util/CASRefPtr.h"
 
 #include "AngelscriptUtils/wrapper/ASCallableConst.h"
 
+#include "CASEventHookList.h"
+#include "CASEventStats.h"
+#include "IASEventHookObserver.h"
+
 class CASModule;
 
 /**
@@ -26,8 +32,16 @@ protected:
 	template<typename SUBCLASS, typename EVENTTYPE, typename RETURNTYPE, RETURNTYPE FAILEDRETURNVAL>
 	friend class CASBaseEventCaller;
 
-private:
-	typedef std::vector<asIScriptFunction*> Functions_t;
+public:
+	/**
+	*	Default number of consecutive failures after which a hook is quarantined.
+	*/
+	static const uint32_t DEFAULT_QUARANTINE_THRESHOLD = 10;
+
+	/**
+	*	Default base back-off period for quarantined hooks, in milliseconds.
+	*/
+	static const uint32_t DEFAULT_QUARANTINE_BACKOFF = 1000;
 
 public:
 	/**
@@ -61,7 +75,13 @@ public:
 	/**
 	*	@return Number of hooked functions.
 	*/
-	size_t GetFunctionCount() const;
+	size_t GetFunctionCount() const { return m_Hooks->GetHookCount(); }
+
+	/**
+	*	@return Whether any functions or native listeners are hooked into this event.
+	*	Call sites can check this before building expensive arguments.
+	*/
+	bool IsHooked() const { return !m_Hooks->IsEmpty() || m_Hooks->HasListeners(); }
 
 	/**
 	*	Gets a hooked function by index.
@@ -71,13 +91,36 @@ public:
 	asIScriptFunction* GetFunctionByIndex( const size_t uiIndex ) const;
 
 	/**
-	*	Adds a new function. Cannot be called while this event is being called.
+	*	Gets the published list of hooks, sorted in dispatch order.
+	*	The list is never modified while the event is being triggered. Hooks added or removed during a call are published after the outermost call has finished.
+	*	The list's indices are brought up to date before it is returned.
+	*	@return Hook list.
+	*/
+	const CASEventHookList& GetHookList() const
+	{
+		m_Hooks->UpdateIndices();
+
+		return *m_Hooks;
+	}
+
+	/**
+	*	Adds a new function. If this event is being called, the function will be called starting with the next call.
 	*	Warning: if the function does not match the event parameters and return type, this will cause problems.
 	*	@param pFunction Function to add.
 	*	@return true if the function was either added or already added before, false otherwise.
 	*/
 	bool AddFunction( asIScriptFunction* pFunction );
 
+	/**
+	*	Adds a new function that is only called when the event is called with the given key.
+	*	@param pFunction Function to add.
+	*	@param iKey Key.
+	*	@return true if the function was either added or already added before, false otherwise.
+	*	@see AddFunction( asIScriptFunction* )
+	*	@see CASEventCaller::CASEventCaller( const int )
+	*/
+	bool AddFunction( asIScriptFunction* pFunction, const int iKey );
+
 	/**
 	*	Hooks a function to an event.
 	*	Used by scripts only.
@@ -88,29 +131,97 @@ public:
 	bool Hook( void* pValue, const int iTypeId );
 
 	/**
-	*	Removes a function. Cannot be called while this event is being called.
+	*	Hooks a function to an event, to be called only when the event is called with the given key.
+	*	Used by scripts only.
+	*	@param pValue Function pointer.
+	*	@param iTypeId Function pointer type id.
+	*	@param iKey Key.
+	*	@return true on success, false otherwise.
+	*/
+	bool HookKeyed( void* pValue, const int iTypeId, const int iKey );
+
+	/**
+	*	Removes a function. If this event is being called, the function is still called by calls that are in progress.
 	*	@param pFunction Function to remove.
 	*/
 	void RemoveFunction( asIScriptFunction* pFunction );
 
 	/**
-	*	Unhooks a function from an event.
+	*	Removes a function that was added with the given key.
+	*	@param pFunction Function to remove.
+	*	@param iKey Key.
+	*/
+	void RemoveFunction( asIScriptFunction* pFunction, const int iKey );
+
+	/**
+	*	Unhooks a function from an event. Hooks for all keys are removed as well.
 	*	Used by scripts only.
 	*	@param pValue Function pointer.
 	*	@param iTypeId Function pointer type id.
 	*/
 	void Unhook( void* pValue, const int iTypeId );
 
+	/**
+	*	Unhooks a function that was hooked with the given key.
+	*	Used by scripts only.
+	*	@param pValue Function pointer.
+	*	@param iTypeId Function pointer type id.
+	*	@param iKey Key.
+	*/
+	void UnhookKeyed( void* pValue, const int iTypeId, const int iKey );
+
+	/**
+	*	@return Whether any functions that belong to the given module are hooked into this event, including changes made during a call.
+	*/
+	bool HasFunctionsOfModule( const CASModule* pModule ) const;
+
 	/**
 	*	Removes all of the functions that belong to the given module.
 	*/
 	void RemoveFunctionsOfModule( CASModule* pModule );
 
 	/**
-	*	Removes all functions.
+	*	Removes all of the functions that belong to any of the given modules in a single pass.
+	*/
+	void RemoveFunctionsOfModules( const std::vector<CASModule*>& modules );
+
+	/**
+	*	Removes all functions. Native listeners are not removed.
 	*/
 	void RemoveAllFunctions();
 
+	/**
+	*	@return Number of native listeners.
+	*/
+	size_t GetListenerCount() const { return m_Hooks->GetListeners().size(); }
+
+	/**
+	*	Adds a native listener. Listeners are called directly, in the same pass as script hooks.
+	*	Listeners with a higher priority are called first. A listener is called before the hooks of modules with the same priority.
+	*	If this event is being called, the listener will be called starting with the next call.
+	*	@param listener Listener to add.
+	*	@param priority Priority.
+	*	@return ID of the listener, used to remove it. INVALID_LISTENER_ID if the listener is empty.
+	*/
+	ListenerID_t AddListener( NativeEventListener_t listener, const as::ModulePriority_t priority = as::ModulePriority::NORMAL );
+
+	/**
+	*	Adds a native listener function.
+	*	@param pFunction Function to add.
+	*	@param pUserData User data to pass to the function.
+	*	@param priority Priority.
+	*	@return ID of the listener, used to remove it. INVALID_LISTENER_ID if the function is null.
+	*	@see AddListener( NativeEventListener_t, const as::ModulePriority_t )
+	*/
+	ListenerID_t AddListener( NativeEventListenerFn pFunction, void* pUserData, const as::ModulePriority_t priority = as::ModulePriority::NORMAL );
+
+	/**
+	*	Removes a native listener. If this event is being called, the listener is still called by calls that are in progress.
+	*	@param id ID of the listener to remove.
+	*	@return true if the listener was removed, false if no listener with this ID exists.
+	*/
+	bool RemoveListener( const ListenerID_t id );
+
 private:
 	/**
 	*	Validates the given hook function.
@@ -130,6 +241,84 @@ public:
 	*/
 	bool IsTriggering() const { return m_iInCallCount != 0; }
 
+	/**
+	*	@return The observer that is notified when hooks are added or removed.
+	*/
+	IASEventHookObserver* GetHookObserver() const { return m_pHookObserver; }
+
+	/**
+	*	Sets the observer that is notified when hooks are added or removed.
+	*/
+	void SetHookObserver( IASEventHookObserver* pObserver )
+	{
+		m_pHookObserver = pObserver;
+	}
+
+	/**
+	*	@return Whether call statistics are recorded for this event and its hooks.
+	*/
+	bool AreStatsEnabled() const { return m_bStatsEnabled; }
+
+	/**
+	*	Sets whether call statistics are recorded for this event and its hooks.
+	*/
+	void SetStatsEnabled( const bool bEnabled )
+	{
+		m_bStatsEnabled = bEnabled;
+	}
+
+	/**
+	*	@return Call statistics for this event. Per-hook statistics are stored in the hook list.
+	*	@see GetHookList
+	*/
+	const CASEventStats& GetStats() const { return m_Stats; }
+
+	/**
+	*	@copydoc GetStats() const
+	*/
+	CASEventStats& GetStats() { return m_Stats; }
+
+	/**
+	*	Clears the statistics of this event and its hooks.
+	*/
+	void ResetStats();
+
+	/**
+	*	@return Number of consecutive failures after which a hook is quarantined. 0 means hooks are never quarantined.
+	*/
+	uint32_t GetQuarantineThreshold() const { return m_uiQuarantineThreshold; }
+
+	/**
+	*	Sets the number of consecutive failures after which a hook is quarantined. 0 means hooks are never quarantined.
+	*/
+	void SetQuarantineThreshold( const uint32_t uiThreshold )
+	{
+		m_uiQuarantineThreshold = uiThreshold;
+	}
+
+	/**
+	*	@return Base back-off period for quarantined hooks, in milliseconds. Doubled each time a hook is quarantined again without succeeding in between.
+	*/
+	uint32_t GetQuarantineBackoff() const { return m_uiQuarantineBackoff; }
+
+	/**
+	*	Sets the base back-off period for quarantined hooks, in milliseconds.
+	*/
+	void SetQuarantineBackoff( const uint32_t uiBackoff )
+	{
+		m_uiQuarantineBackoff = uiBackoff;
+	}
+
+	/**
+	*	@return Number of hooks that are currently quarantined because they kept failing.
+	*/
+	uint32_t GetQuarantinedHookCount() const;
+
+	/**
+	*	Releases all quarantined hooks, and clears their failure history.
+	*/
+	void ReleaseQuarantinedHooks();
+
 protected:
 	/**
 	*	@return The call count.
@@ -156,47 +345,122 @@ protected:
 	}
 
 	/**
-	*	If a script called Unhook while in this event's hook invocation it'll leave behind a null pointer.
-	*	This cleans up those hooks.
+	*	If hooks were added or removed while this event was being triggered, publishes the new list of hooks.
+	*	Does nothing while the event is still being triggered.
 	*/
-	void ClearRemovedHooks();
+	void PublishPendingHooks();
+
+private:
+	/**
+	*	@return A hook list that can be modified without affecting calls that are in progress.
+	*/
+	CASEventHookList& GetWritableHookList();
+
+	/**
+	*	Notifies the observer, if any, that the hooks of the given function's module have changed.
+	*/
+	void NotifyHooksChanged( const asIScriptFunction* pFunction );
 
 private:
 	const asDWORD m_AccessMask;
 
 	asIScriptFunction* m_pFuncDef = nullptr;
 
-	Functions_t m_Functions;
+	//Published hooks. Only replaced while this event is not being triggered.
+	CASRefPtr<CASEventHookList> m_Hooks;
 
-	//Used to prevent adding/removing hooks while invoking the hook in question.
+	//Hooks added or removed while this event is being triggered. Published after the outermost call.
+	CASRefPtr<CASEventHookList> m_PendingHooks;
+
+	//Used to defer changes to the hook list while invoking hooks.
 	int m_iInCallCount = 0;
 
+	IASEventHookObserver* m_pHookObserver = nullptr;
+
+	ListenerID_t m_uiNextListenerID = INVALID_LISTENER_ID + 1;
+
+	bool m_bStatsEnabled = false;
+
+	CASEventStats m_Stats;
+
+	uint32_t m_uiQuarantineThreshold = DEFAULT_QUARANTINE_THRESHOLD;
+	uint32_t m_uiQuarantineBackoff = DEFAULT_QUARANTINE_BACKOFF;
+
 private:
 	CASBaseEvent( const CASBaseEvent& ) = delete;
 	CASBaseEvent& operator=( const CASBaseEvent& ) = delete;
 };
 
 /**
-*	Registers CBaseEvent class members for pszObjectName. Also registers casts to and from pszObjectName if it differs from CBaseEvent.
+*	Registers CBaseEvent class members for pszObjectName, without registering any casts.
 *	@param engine Script engine.
 *	@param pszObjectName Name of the class that is being registered.
 */
 template<typename CLASS>
-void RegisterScriptCBaseEvent( asIScriptEngine& engine, const char* const pszObjectName )
+void RegisterScriptCBaseEventMethods( asIScriptEngine& engine, const char* const pszObjectName )
 {
-	as::RegisterCasts<CASBaseEvent, CLASS>( engine, "CBaseEvent", pszObjectName, &as::Cast_UpCast, &as::Cast_DownCast );
-
 	engine.RegisterObjectMethod(
 		pszObjectName, "bool Hook(?& in pFunction)",
 		asMETHOD( CLASS, Hook ), asCALL_THISCALL );
 
+	engine.RegisterObjectMethod(
+		pszObjectName, "bool Hook(?& in pFunction, const int iKey)",
+		asMETHOD( CLASS, HookKeyed ), asCALL_THISCALL );
+
 	engine.RegisterObjectMethod(
 		pszObjectName, "void Unhook(?& in pFunction)",
 		asMETHOD( CLASS, Unhook ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "void Unhook(?& in pFunction, const int iKey)",
+		asMETHOD( CLASS, UnhookKeyed ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "bool AreStatsEnabled() const",
+		asMETHOD( CLASS, AreStatsEnabled ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "void SetStatsEnabled(const bool bEnabled)",
+		asMETHOD( CLASS, SetStatsEnabled ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "const CEventStats& GetStats() const",
+		asMETHODPR( CLASS, GetStats, () const, const CASEventStats& ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "void ResetStats()",
+		asMETHOD( CLASS, ResetStats ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "uint GetQuarantinedHookCount() const",
+		asMETHOD( CLASS, GetQuarantinedHookCount ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "void ReleaseQuarantinedHooks()",
+		asMETHOD( CLASS, ReleaseQuarantinedHooks ), asCALL_THISCALL );
 }
 
 /**
-*	Registers the CBaseEvent class.
+*	Registers CBaseEvent class members for pszObjectName. Also registers casts to and from pszObjectName if it differs from CBaseEvent.
+*	@param engine Script engine.
+*	@param pszObjectName Name of the class that is being registered.
+*/
+template<typename CLASS>
+void RegisterScriptCBaseEvent( asIScriptEngine& engine, const char* const pszObjectName )
+{
+	as::RegisterCasts<CASBaseEvent, CLASS>( engine, "CBaseEvent", pszObjectName, &as::Cast_UpCast, &as::Cast_DownCast );
+
+	RegisterScriptCBaseEventMethods<CLASS>( engine, pszObjectName );
+}
+
+/**
+*	Registers the CEventStats class.
+*	@param engine Script engine.
+*/
+void RegisterScriptCEventStats( asIScriptEngine& engine );
+
+/**
+*	Registers the CBaseEvent class. CEventStats must be registered first.
 *	@param engine Script engine.
 */
 void RegisterScriptCBaseEvent( asIScriptEngine& engine );
@@ -15,6 +15,11 @@
 *	A method with this format:
 *	ReturnType_t CallEvent( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, va_list list )
 *	This method will perform the actual call to the hook.
+*	To support CallArgs with other argument list types, the subclass must provide CallEvent overloads that accept them as const references.
+*
+*	The subclass can optionally provide a method with this format:
+*	bool SkipUnhooked( EventType_t& event, ReturnType_t& result )
+*	If it returns true, events without hooks return result immediately, without acquiring a context.
 *
 *	@tparam SUBCLASS Class that inherits from this class.
 *	@tparam EVENTTYPE Represents the type of the event being called.
@@ -60,8 +65,14 @@ public:
 
 	/**
 	*	Forwards the call to the subclass.
+	*	@param event Event to call.
+	*	@param pContext Context to use.
+	*	@param flags Call flags.
+	*	@param args Argument list. The subclass must provide a CallEvent overload for this type.
+	*	@tparam ARGS Argument list type.
 	*/
-	inline ReturnType_t VCall( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, va_list list )
+	template<typename ARGS>
+	inline ReturnType_t CallArgs( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, const ARGS& args )
 	{
 		//Take care of some common bookkeeping here.
 		assert( pContext );
@@ -69,20 +80,56 @@ public:
 		if( !pContext )
 			return FAILED_RETURN_VALUE;
 
+		ReturnType_t result = FAILED_RETURN_VALUE;
+
+		if( !event.IsHooked() && static_cast<SubClass_t*>( this )->SkipUnhooked( event, result ) )
+			return result;
+
 		IncrementCallCount( event );
 
-		auto result = static_cast<SubClass_t*>( this )->CallEvent( event, pContext, flags, list );
+		result = static_cast<SubClass_t*>( this )->CallEvent( event, pContext, flags, args );
 
 		DecrementCallCount( event );
 
 		assert( GetCallCount( event ) >= 0 );
 
-		//Clear any removed hooks.
-		event.ClearRemovedHooks();
+		//Publish any hooks that were added or removed during the call.
+		event.PublishPendingHooks();
 
 		return result;
 	}
 
+	/**
+	*	Calls the given event using a context acquired from the given engine.
+	*	If a script is executing with a context from this engine, that context is used instead, and hooks are called as nested calls.
+	*	@param event Event to call.
+	*	@param pScriptEngine Script engine to use.
+	*	@param flags Call flags.
+	*	@param args Argument list. The subclass must provide a CallEvent overload for this type.
+	*	@tparam ARGS Argument list type.
+	*/
+	template<typename ARGS>
+	inline ReturnType_t CallArgs( EventType_t& event, asIScriptEngine* pScriptEngine, CallFlags_t flags, const ARGS& args )
+	{
+		ReturnType_t result = FAILED_RETURN_VALUE;
+
+		//Don't bother acquiring a context if nothing is listening.
+		if( !event.IsHooked() && static_cast<SubClass_t*>( this )->SkipUnhooked( event, result ) )
+			return result;
+
+		CASOwningContext ctx( *pScriptEngine, true );
+
+		return CallArgs( event, ctx.GetContext(), flags, args );
+	}
+
+	/**
+	*	Forwards the call to the subclass.
+	*/
+	inline ReturnType_t VCall( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, va_list list )
+	{
+		return CallArgs( event, pContext, flags, list );
+	}
+
 	/**
 	*	Calls the given event using the given context.
 	*	@param event Event to call.
@@ -96,6 +143,7 @@ public:
 
 	/**
 	*	Calls the given event using a context acquired from the given engine.
+	*	If a script is executing with a context from this engine, that context is used instead, and hooks are called as nested calls.
 	*	@param event Event to call.
 	*	@param pScriptEngine Script engine to use.
 	*	@param flags Call flags.
@@ -103,30 +151,19 @@ public:
 	*/
 	inline ReturnType_t VCall( EventType_t& event, asIScriptEngine* pScriptEngine, CallFlags_t flags, va_list list )
 	{
-		auto pContext = pScriptEngine->RequestContext();
-
-		auto result = VCall( event, pContext, flags, list );
-
-		pScriptEngine->ReturnContext( pContext );
-
-		return result;
+		return CallArgs( event, pScriptEngine, flags, list );
 	}
 
 	/**
 	*	Calls the given event using a context acquired from the given engine.
+	*	If a script is executing with a context from this engine, that context is used instead, and hooks are called as nested calls.
 	*	@param event Event to call.
 	*	@param pScriptEngine Script engine to use.
 	*	@param list Arguments.
 	*/
 	inline ReturnType_t VCall( EventType_t& event, asIScriptEngine* pScriptEngine, va_list list )
 	{
-		auto pContext = pScriptEngine->RequestContext();
-
-		auto result = VCall( event, pContext, CallFlag::NONE, list );
-
-		pScriptEngine->ReturnContext( pContext );
-
-		return result;
+		return CallArgs( event, pScriptEngine, CallFlag::NONE, list );
 	}
 
 	/**
@@ -167,6 +204,7 @@ public:
 
 	/**
 	*	Calls the given event using a context acquired from the given engine.
+	*	If a script is executing with a context from this engine, that context is used instead, and hooks are called as nested calls.
 	*	@param event Event to call.
 	*	@param pScriptEngine Script engine to use.
 	*	@param flags Call flags.
@@ -187,6 +225,7 @@ public:
 
 	/**
 	*	Calls the given event using a context acquired from the given engine.
+	*	If a script is executing with a context from this engine, that context is used instead, and hooks are called as nested calls.
 	*	@param event Event to call.
 	*	@param pScriptEngine Script engine to use.
 	*	@param ... Arguments.
@@ -204,6 +243,18 @@ public:
 		return result;
 	}
 
+	/**
+	*	Called when the event has no hooks. By default, the event is called anyway.
+	*	Non-virtual, uses templates to invoke the correct type.
+	*	@param event Event being called.
+	*	@param[ out ] result Value to return if the call is skipped.
+	*	@return true if the call should be skipped, false otherwise.
+	*/
+	bool SkipUnhooked( EventType_t&, ReturnType_t& )
+	{
+		return false;
+	}
+
 protected:
 	//These provide access to the event's call counter
 	int GetCallCount( EventType_t& event )
@@ -0,0 +1,194 @@
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <utility>
+
+#include "CASEvent.h"
+
+#include "CASDeferredEventQueue.h"
+
+namespace
+{
+size_t RoundUpToPowerOf2( size_t uiValue )
+{
+	size_t uiResult = 2;
+
+	while( uiResult < uiValue )
+		uiResult <<= 1;
+
+	return uiResult;
+}
+}
+
+CASDeferredEventQueue::CASDeferredEventQueue( const size_t uiCapacity )
+	: m_uiEnqueuePos( 0 )
+	, m_uiDroppedCount( 0 )
+{
+	const auto uiSize = RoundUpToPowerOf2( uiCapacity );
+
+	m_Slots.reset( new Slot[ uiSize ] );
+	m_uiMask = uiSize - 1;
+
+	for( size_t uiIndex = 0; uiIndex < uiSize; ++uiIndex )
+	{
+		m_Slots[ uiIndex ].sequence.store( uiIndex, std::memory_order_relaxed );
+	}
+}
+
+bool CASDeferredEventQueue::Post( CASEvent& event, CASArgumentBlock&& arguments )
+{
+	Slot* pSlot;
+
+	auto uiPos = m_uiEnqueuePos.load( std::memory_order_relaxed );
+
+	//Claim a slot. Each slot's sequence tells producers whether it's free for the given position.
+	for( ;; )
+	{
+		pSlot = &m_Slots[ uiPos & m_uiMask ];
+
+		const auto uiSequence = pSlot->sequence.load( std::memory_order_acquire );
+
+		const auto iDiff = static_cast<intptr_t>( uiSequence ) - static_cast<intptr_t>( uiPos );
+
+		if( iDiff == 0 )
+		{
+			if( m_uiEnqueuePos.compare_exchange_weak( uiPos, uiPos + 1, std::memory_order_relaxed ) )
+				break;
+		}
+		else if( iDiff < 0 )
+		{
+			//Full.
+			m_uiDroppedCount.fetch_add( 1, std::memory_order_relaxed );
+			return false;
+		}
+		else
+		{
+			uiPos = m_uiEnqueuePos.load( std::memory_order_relaxed );
+		}
+	}
+
+	pSlot->event.pEvent = &event;
+	pSlot->event.arguments = std::move( arguments );
+
+	//Publish to the consumer.
+	pSlot->sequence.store( uiPos + 1, std::memory_order_release );
+
+	return true;
+}
+
+bool CASDeferredEventQueue::Pop( CASDeferredEvent& outEvent )
+{
+	auto& slot = m_Slots[ m_uiDequeuePos & m_uiMask ];
+
+	const auto uiSequence = slot.sequence.load( std::memory_order_acquire );
+
+	//Not published yet.
+	if( uiSequence != m_uiDequeuePos + 1 )
+		return false;
+
+	outEvent.pEvent = slot.event.pEvent;
+	outEvent.arguments = std::move( slot.event.arguments );
+
+	slot.event.pEvent = nullptr;
+
+	//Free the slot for the next lap.
+	slot.sequence.store( m_uiDequeuePos + m_uiMask + 1, std::memory_order_release );
+
+	++m_uiDequeuePos;
+
+	return true;
+}
+
+bool CASDeferredEventQueue::IsEmpty() const
+{
+	return m_Slots[ m_uiDequeuePos & m_uiMask ].sequence.load( std::memory_order_acquire ) != m_uiDequeuePos + 1;
+}
+
+CASCoalescedEventQueue::CASCoalescedEventQueue( const size_t uiCapacity )
+	: m_uiCapacity( uiCapacity )
+{
+}
+
+bool CASCoalescedEventQueue::Post( CASEvent& event, const uint64_t uiKey, CASArgumentBlock&& arguments )
+{
+	std::lock_guard<std::mutex> guard( m_Mutex );
+
+	const Key key{ &event, uiKey };
+
+	auto it = m_Indices.find( key );
+
+	if( it == m_Indices.end() )
+	{
+		//Full.
+		if( m_Events.size() >= m_uiCapacity )
+		{
+			m_uiDroppedCount.fetch_add( 1, std::memory_order_relaxed );
+			return false;
+		}
+
+		m_Indices.emplace( key, m_Events.size() );
+
+		m_Events.emplace_back();
+
+		auto& entry = m_Events.back();
+
+		entry.pEvent = &event;
+		entry.uiKey = uiKey;
+		entry.arguments = std::move( arguments );
+
+		return true;
+	}
+
+	auto& current = m_Events[ it->second ].arguments;
+
+	if( auto pMerge = event.GetCoalesceMerge() )
+		pMerge( current, std::move( arguments ), event.GetCoalesceMergeUserData() );
+	else
+		current = std::move( arguments );
+
+	m_uiMergedCount.fetch_add( 1, std::memory_order_relaxed );
+
+	return true;
+}
+
+void CASCoalescedEventQueue::TakeEvents( Events_t& outEvents, const size_t uiMaxCount )
+{
+	assert( outEvents.empty() );
+
+	std::lock_guard<std::mutex> guard( m_Mutex );
+
+	if( uiMaxCount != 0 && uiMaxCount < m_Events.size() )
+	{
+		outEvents.reserve( uiMaxCount );
+
+		std::move( m_Events.begin(), m_Events.begin() + uiMaxCount, std::back_inserter( outEvents ) );
+
+		m_Events.erase( m_Events.begin(), m_Events.begin() + uiMaxCount );
+
+		//The remaining entries moved to the front.
+		m_Indices.clear();
+
+		for( size_t uiIndex = 0; uiIndex < m_Events.size(); ++uiIndex )
+		{
+			const auto& entry = m_Events[ uiIndex ];
+
+			m_Indices.emplace( Key{ entry.pEvent, entry.uiKey }, uiIndex );
+		}
+
+		return;
+	}
+
+	outEvents.swap( m_Events );
+
+	//Keep the capacity, events are usually posted at the same rate every frame.
+	m_Events.reserve( outEvents.size() );
+
+	m_Indices.clear();
+}
+
+bool CASCoalescedEventQueue::IsEmpty()
+{
+	std::lock_guard<std::mutex> guard( m_Mutex );
+
+	return m_Events.empty();
+}
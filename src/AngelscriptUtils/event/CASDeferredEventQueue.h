@@ -0,0 +1,208 @@
+#ifndef ANGELSCRIPT_CASDEFERREDEVENTQUEUE_H
+#define ANGELSCRIPT_CASDEFERREDEVENTQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "AngelscriptUtils/wrapper/CASArgumentBlock.h"
+
+class CASEvent;
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+/**
+*	An event that was posted to be called later, along with its arguments.
+*/
+struct CASDeferredEvent final
+{
+	CASEvent* pEvent = nullptr;
+
+	//Coalescing key. Only used by coalesced events.
+	uint64_t uiKey = 0;
+
+	CASArgumentBlock arguments;
+};
+
+/**
+*	Bounded lock-free queue of deferred events.
+*	Any number of threads can post events. Only one thread, the one that runs scripts, may pop them.
+*/
+class CASDeferredEventQueue final
+{
+public:
+	/**
+	*	Constructor.
+	*	@param uiCapacity Maximum number of events that can be queued. Rounded up to a power of 2.
+	*/
+	CASDeferredEventQueue( const size_t uiCapacity );
+	~CASDeferredEventQueue() = default;
+
+	/**
+	*	@return Maximum number of events that can be queued.
+	*/
+	size_t GetCapacity() const { return m_uiMask + 1; }
+
+	/**
+	*	@return Number of events that could not be posted because the queue was full.
+	*/
+	uint32_t GetDroppedCount() const { return m_uiDroppedCount.load( std::memory_order_relaxed ); }
+
+	/**
+	*	Posts an event. Can be called from any thread.
+	*	@param event Event to post.
+	*	@param arguments Arguments to pass to the event. Moved into the queue.
+	*	@return true if the event was queued, false if the queue is full.
+	*/
+	bool Post( CASEvent& event, CASArgumentBlock&& arguments );
+
+	/**
+	*	Pops the oldest event. Must only be called from the consumer thread.
+	*	@param[ out ] outEvent The event.
+	*	@return true if an event was popped, false if the queue is empty.
+	*/
+	bool Pop( CASDeferredEvent& outEvent );
+
+	/**
+	*	@return Whether there are no events to pop. Must only be called from the consumer thread.
+	*/
+	bool IsEmpty() const;
+
+private:
+	struct Slot final
+	{
+		std::atomic<size_t> sequence;
+
+		CASDeferredEvent event;
+	};
+
+	std::unique_ptr<Slot[]> m_Slots;
+
+	size_t m_uiMask;
+
+	//Keep producer and consumer positions on separate cache lines.
+	char m_Padding1[ 64 ];
+
+	std::atomic<size_t> m_uiEnqueuePos;
+
+	char m_Padding2[ 64 ];
+
+	//Only accessed by the consumer.
+	size_t m_uiDequeuePos = 0;
+
+	std::atomic<uint32_t> m_uiDroppedCount;
+
+private:
+	CASDeferredEventQueue( const CASDeferredEventQueue& ) = delete;
+	CASDeferredEventQueue& operator=( const CASDeferredEventQueue& ) = delete;
+};
+
+/**
+*	Queue of coalesced deferred events.
+*	Posts of the same event with the same key are merged into the pending entry until the queue is flushed,
+*	so each key is delivered at most once per flush. Entries are delivered in the order that they were first posted.
+*	The number of pending entries is bounded. Posts that would add an entry to a full queue are dropped, merges are always accepted.
+*	Any number of threads can post events. Only one thread, the one that runs scripts, may take them.
+*/
+class CASCoalescedEventQueue final
+{
+public:
+	typedef std::vector<CASDeferredEvent> Events_t;
+
+public:
+	/**
+	*	Constructor.
+	*	@param uiCapacity Maximum number of pending entries.
+	*/
+	CASCoalescedEventQueue( const size_t uiCapacity );
+	~CASCoalescedEventQueue() = default;
+
+	/**
+	*	@return Maximum number of pending entries.
+	*/
+	size_t GetCapacity() const { return m_uiCapacity; }
+
+	/**
+	*	@return Number of posts that could not be queued because the queue was full.
+	*/
+	uint32_t GetDroppedCount() const { return m_uiDroppedCount.load( std::memory_order_relaxed ); }
+
+	/**
+	*	@return Number of posts that were merged into a pending entry.
+	*/
+	uint32_t GetMergedCount() const { return m_uiMergedCount.load( std::memory_order_relaxed ); }
+
+	/**
+	*	Posts an event. If an entry with the same event and key is pending, the arguments are merged into it
+	*	using the event's merge function, or replace its arguments if it has none.
+	*	@param event Event to post.
+	*	@param uiKey Coalescing key.
+	*	@param arguments Arguments to pass to the event. Moved into the queue.
+	*	@return true if the post was queued or merged, false if the queue is full.
+	*/
+	bool Post( CASEvent& event, const uint64_t uiKey, CASArgumentBlock&& arguments );
+
+	/**
+	*	Takes pending entries. Events posted after this call are coalesced separately from the entries that were taken.
+	*	Entries that are not taken remain pending, and can still be merged into.
+	*	Must only be called from the consumer thread.
+	*	@param[ out ] outEvents Receives the entries, in the order that they were first posted. Must be empty.
+	*	@param uiMaxCount Maximum number of entries to take. 0 means no limit.
+	*/
+	void TakeEvents( Events_t& outEvents, const size_t uiMaxCount = 0 );
+
+	/**
+	*	@return Whether there are no pending entries.
+	*/
+	bool IsEmpty();
+
+private:
+	struct Key final
+	{
+		const CASEvent* pEvent;
+		uint64_t uiKey;
+
+		bool operator==( const Key& other ) const
+		{
+			return pEvent == other.pEvent && uiKey == other.uiKey;
+		}
+	};
+
+	struct KeyHash final
+	{
+		size_t operator()( const Key& key ) const
+		{
+			return std::hash<const CASEvent*>()( key.pEvent ) ^ ( std::hash<uint64_t>()( key.uiKey ) * 31 );
+		}
+	};
+
+	const size_t m_uiCapacity;
+
+	std::mutex m_Mutex;
+
+	Events_t m_Events;
+
+	//Maps keys to indices in m_Events.
+	std::unordered_map<Key, size_t, KeyHash> m_Indices;
+
+	std::atomic<uint32_t> m_uiMergedCount{ 0 };
+
+	std::atomic<uint32_t> m_uiDroppedCount{ 0 };
+
+private:
+	CASCoalescedEventQueue( const CASCoalescedEventQueue& ) = delete;
+	CASCoalescedEventQueue& operator=( const CASCoalescedEventQueue& ) = delete;
+};
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASDEFERREDEVENTQUEUE_H
@@ -5,6 +5,9 @@
 
 #include "CASBaseEvent.h"
 
+class CASArgumentBlock;
+class CASEventRecorder;
+
 /**
 *	@addtogroup ASEvents
 *
@@ -32,6 +35,14 @@ enum class EventStopMode
 	ON_HANDLED
 };
 
+/**
+*	Merges a coalesced event's pending arguments with the arguments of a newer post.
+*	@param current Arguments that are pending delivery. Should be updated to contain the merged arguments.
+*	@param incoming Arguments of the newer post.
+*	@param pUserData User data that was passed to CASEvent::SetCoalesced.
+*/
+typedef void ( *CoalesceMergeFn )( CASArgumentBlock& current, CASArgumentBlock&& incoming, void* pUserData );
+
 /**
 *	Represents an event that script functions can hook into.
 */
@@ -69,6 +80,52 @@ public:
 	*/
 	EventStopMode GetStopMode() const { return m_StopMode; }
 
+	/**
+	*	@return Whether deferred posts of this event are coalesced.
+	*	@see CASEventManager::PostEvent( CASEvent&, const uint64_t, CASArgumentBlock&& )
+	*/
+	bool IsCoalesced() const { return m_bCoalesced; }
+
+	/**
+	*	@return The function used to merge coalesced posts, or null if the newest post replaces older ones.
+	*/
+	CoalesceMergeFn GetCoalesceMerge() const { return m_pCoalesceMerge; }
+
+	/**
+	*	@return User data passed to the merge function.
+	*/
+	void* GetCoalesceMergeUserData() const { return m_pCoalesceMergeUserData; }
+
+	/**
+	*	Sets whether deferred posts of this event are coalesced.
+	*	Coalesced posts that have the same key are merged until the deferred events are processed, and are delivered once.
+	*	This is not synchronized with posting threads: configure it before the event is first posted,
+	*	and only change it while no other thread can post it and no posts of it are pending.
+	*	@param bCoalesced Whether to coalesce posts.
+	*	@param pMerge Function that merges posts. If null, the newest post replaces older ones.
+	*	@param pUserData User data to pass to the merge function.
+	*/
+	void SetCoalesced( const bool bCoalesced, CoalesceMergeFn pMerge = nullptr, void* pUserData = nullptr )
+	{
+		m_bCoalesced = bCoalesced;
+		m_pCoalesceMerge = pMerge;
+		m_pCoalesceMergeUserData = pUserData;
+	}
+
+	/**
+	*	@return The recorder that records calls to this event, if any.
+	*/
+	CASEventRecorder* GetRecorder() const { return m_pRecorder; }
+
+	/**
+	*	Sets the recorder that records calls to this event.
+	*	@see CASEventManager::StartRecording
+	*/
+	void SetRecorder( CASEventRecorder* pRecorder )
+	{
+		m_pRecorder = pRecorder;
+	}
+
 	/**
 	*	Dumps all hooked functions to stdout.
 	*/
@@ -81,6 +138,12 @@ private:
 
 	const EventStopMode m_StopMode;
 
+	bool m_bCoalesced = false;
+	CoalesceMergeFn m_pCoalesceMerge = nullptr;
+	void* m_pCoalesceMergeUserData = nullptr;
+
+	CASEventRecorder* m_pRecorder = nullptr;
+
 private:
 	CASEvent( const CASEvent& ) = delete;
 	CASEvent& operator=( const CASEvent& ) = delete;
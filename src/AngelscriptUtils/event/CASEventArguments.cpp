@@ -0,0 +1,121 @@
+#include <cstring>
+
+#include "CASEventArguments.h"
+
+namespace
+{
+bool IsStringType( const asIScriptFunction* pFuncDef, const int iTypeId )
+{
+	if( !pFuncDef || ( iTypeId & asTYPEID_OBJHANDLE ) )
+		return false;
+
+	auto pType = pFuncDef->GetEngine()->GetTypeInfoById( iTypeId );
+
+	return pType && strcmp( pType->GetName(), "string" ) == 0;
+}
+}
+
+CASEventArguments::~CASEventArguments()
+{
+}
+
+bool CASEventArguments::ToArgumentBlock( CASArgumentBlock& block ) const
+{
+	const auto uiCount = GetCount();
+
+	CASEventArgument arg;
+
+	for( size_t uiArg = 0; uiArg < uiCount; ++uiArg )
+	{
+		if( !GetArgument( uiArg, arg ) )
+			return false;
+
+		bool bAdded;
+
+		if( arg.pString )
+			bAdded = block.Add( *arg.pString );
+		else if( as::IsEnum( arg.iTypeId ) )
+			bAdded = block.Add( static_cast<int32_t>( arg.value.dword ) );
+		else if( as::IsPrimitive( arg.iTypeId ) )
+			bAdded = block.AddPrimitive( arg.iTypeId, arg.value );
+		else
+			bAdded = false;
+
+		if( !bAdded )
+			return false;
+	}
+
+	return true;
+}
+
+bool CASEventArguments::GetArgument( const CASArgumentBlock& args, const size_t uiIndex, CASEventArgument& arg ) const
+{
+	if( uiIndex >= args.GetArgumentCount() )
+		return false;
+
+	if( args.IsString( uiIndex ) )
+	{
+		arg.pString = &args.GetString( uiIndex );
+	}
+	else
+	{
+		arg.iTypeId = args.GetTypeId( uiIndex );
+		arg.value = args.GetValue( uiIndex );
+	}
+
+	return true;
+}
+
+bool CASEventArguments::GetArgument( const CASArguments& args, const size_t uiIndex, CASEventArgument& arg ) const
+{
+	auto pArg = args.GetArgument( uiIndex );
+
+	if( !pArg )
+		return false;
+
+	switch( pArg->GetArgumentType() )
+	{
+	case ArgType::PRIMITIVE:
+	case ArgType::ENUM:
+		{
+			arg.iTypeId = pArg->GetTypeId();
+			arg.value = pArg->GetArgumentValue();
+			return true;
+		}
+
+	case ArgType::VALUE:
+	case ArgType::REF:
+		{
+			if( IsStringType( m_pFuncDef, pArg->GetTypeId() ) )
+			{
+				arg.pString = reinterpret_cast<const std::string*>( pArg->GetArgumentValue().pValue );
+			}
+			else
+			{
+				arg.iTypeId = pArg->GetTypeId();
+				arg.value = pArg->GetArgumentValue();
+			}
+
+			return true;
+		}
+
+	default: return false;
+	}
+}
+
+bool CASEventArguments::GetArgument( va_list list, const size_t uiIndex, CASEventArgument& arg ) const
+{
+	if( !m_pFuncDef )
+		return false;
+
+	if( !m_VarArgs )
+	{
+		//Copies the list, so the caller can still use it. The funcdef is only used to read the parameter types.
+		m_VarArgs.reset( new CASArguments( *const_cast<asIScriptFunction*>( m_pFuncDef ), list ) );
+	}
+
+	if( m_VarArgs->GetArgumentCount() != m_pFuncDef->GetParamCount() )
+		return false;
+
+	return GetArgument( *m_VarArgs, uiIndex, arg );
+}
@@ -0,0 +1,332 @@
+#ifndef ANGELSCRIPT_CASEVENTARGUMENTS_H
+#define ANGELSCRIPT_CASEVENTARGUMENTS_H
+
+#include <cassert>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#include <angelscript.h>
+
+#include "AngelscriptUtils/util/ASUtil.h"
+
+#include "AngelscriptUtils/wrapper/CASArgumentBlock.h"
+#include "AngelscriptUtils/wrapper/CASArguments.h"
+#include "AngelscriptUtils/wrapper/CASTypedArguments.h"
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+/**
+*	A single argument of an event call, as seen by native listeners.
+*/
+struct CASEventArgument final
+{
+	/**
+	*	Script type id of primitive, enum and object arguments. asTYPEID_VOID for strings.
+	*/
+	int iTypeId = asTYPEID_VOID;
+
+	/**
+	*	Value of primitive and enum arguments. Objects store their address in pValue.
+	*/
+	ArgumentValue value;
+
+	/**
+	*	The string, if the argument is a string. Null otherwise.
+	*/
+	const std::string* pString = nullptr;
+};
+
+namespace as
+{
+/**
+*	Converts between C++ types and event arguments.
+*	Specializations must provide:
+*	static bool Describe( const T& value, CASEventArgument& arg ): describes a statically typed argument. Returns false if the type can't be described.
+*	static bool Get( const CASEventArgument& arg, T& value ): reads an argument. Returns false if the argument has a different type.
+*	@tparam T C++ type, without references or cv-qualifiers.
+*/
+template<typename T, typename ENABLE = void>
+struct EventArgumentTraits
+{
+	static bool Describe( const T&, CASEventArgument& )
+	{
+		return false;
+	}
+};
+
+/**
+*	Defines event argument traits for a primitive type.
+*	@param type C++ type.
+*	@param typeId Script type id.
+*	@param member ArgumentValue member that holds the value.
+*/
+#define __AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( type, typeId, member )											\
+template<>																									\
+struct EventArgumentTraits<type>																			\
+{																											\
+	static bool Describe( const type& value, CASEventArgument& arg )										\
+	{																										\
+		arg.iTypeId = typeId;																				\
+		arg.value.member = value;																			\
+		return true;																						\
+	}																										\
+																											\
+	static bool Get( const CASEventArgument& arg, type& value )												\
+	{																										\
+		if( arg.iTypeId != typeId )																			\
+			return false;																					\
+																											\
+		value = static_cast<type>( arg.value.member );														\
+		return true;																						\
+	}																										\
+}
+
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( bool, asTYPEID_BOOL, byte );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( int8_t, asTYPEID_INT8, byte );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( int16_t, asTYPEID_INT16, word );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( int32_t, asTYPEID_INT32, dword );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( int64_t, asTYPEID_INT64, qword );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( uint8_t, asTYPEID_UINT8, byte );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( uint16_t, asTYPEID_UINT16, word );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( uint32_t, asTYPEID_UINT32, dword );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( uint64_t, asTYPEID_UINT64, qword );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( float, asTYPEID_FLOAT, flValue );
+__AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS( double, asTYPEID_DOUBLE, dValue );
+
+#undef __AS_PRIMITIVE_EVENT_ARGUMENT_TRAITS
+
+/**
+*	Enums are read from script enums, and from 32 bit integers, which is how argument blocks store them.
+*	Any script enum is accepted, since the script enum that corresponds to T is not known.
+*/
+template<typename T>
+struct EventArgumentTraits<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+	static_assert( sizeof( T ) == sizeof( asDWORD ), "Enum arguments must be 32 bits" );
+
+	static bool Describe( const T& value, CASEventArgument& arg )
+	{
+		arg.iTypeId = asTYPEID_INT32;
+		arg.value.dword = static_cast<asDWORD>( value );
+		return true;
+	}
+
+	static bool Get( const CASEventArgument& arg, T& value )
+	{
+		if( arg.iTypeId != asTYPEID_INT32 && !as::IsEnum( arg.iTypeId ) )
+			return false;
+
+		value = static_cast<T>( arg.value.dword );
+		return true;
+	}
+};
+
+/**
+*	Strings are copied out of the argument.
+*/
+template<>
+struct EventArgumentTraits<std::string>
+{
+	static bool Describe( const std::string& szValue, CASEventArgument& arg )
+	{
+		arg.pString = &szValue;
+		return true;
+	}
+
+	static bool Get( const CASEventArgument& arg, std::string& szValue )
+	{
+		if( !arg.pString )
+			return false;
+
+		szValue = *arg.pString;
+		return true;
+	}
+};
+
+/**
+*	Helper that describes the element of a tuple at a given index.
+*	Do not use directly.
+*	@tparam INDEX Number of elements to process.
+*/
+template<size_t INDEX, typename... ARGS>
+struct EventArgumentsHelper final
+{
+	typedef typename std::decay<typename std::tuple_element<INDEX - 1, std::tuple<ARGS...>>::type>::type Type_t;
+
+	static bool Describe( const std::tuple<ARGS...>& args, const size_t uiIndex, CASEventArgument& arg )
+	{
+		if( uiIndex == INDEX - 1 )
+			return EventArgumentTraits<Type_t>::Describe( std::get<INDEX - 1>( args ), arg );
+
+		return EventArgumentsHelper<INDEX - 1, ARGS...>::Describe( args, uiIndex, arg );
+	}
+};
+
+template<typename... ARGS>
+struct EventArgumentsHelper<0, ARGS...> final
+{
+	static bool Describe( const std::tuple<ARGS...>&, const size_t, CASEventArgument& )
+	{
+		return false;
+	}
+};
+}
+
+/**
+*	Type erased view of the arguments of an event call.
+*	Passed to native listeners, so they can access the arguments regardless of how the event was called.
+*	Only valid during the call.
+*/
+class CASEventArguments final
+{
+private:
+	typedef size_t ( *GetCountFn )( const CASEventArguments& args );
+	typedef bool ( *GetArgumentFn )( const CASEventArguments& args, const size_t uiIndex, CASEventArgument& arg );
+
+public:
+	/**
+	*	Constructor.
+	*	@param pFuncDef The event's funcdef.
+	*	@param args Arguments. Must outlive this object.
+	*/
+	template<typename ARGS>
+	CASEventArguments( const asIScriptFunction* pFuncDef, const ARGS& args )
+		: m_pFuncDef( pFuncDef )
+		, m_pArguments( &args )
+		, m_pGetCount( &GetCountImpl<ARGS> )
+		, m_pGetArgument( &GetArgumentImpl<ARGS> )
+	{
+	}
+
+	~CASEventArguments();
+
+	/**
+	*	@return The event's funcdef.
+	*/
+	const asIScriptFunction* GetFuncDef() const { return m_pFuncDef; }
+
+	/**
+	*	@return The number of arguments.
+	*/
+	size_t GetCount() const { return m_pGetCount( *this ); }
+
+	/**
+	*	Gets an argument.
+	*	@param uiIndex Argument index.
+	*	@param[ out ] arg The argument.
+	*	@return true on success, false if the index is out of range or the argument can't be described.
+	*/
+	bool GetArgument( const size_t uiIndex, CASEventArgument& arg ) const
+	{
+		arg = CASEventArgument();
+
+		return m_pGetArgument( *this, uiIndex, arg );
+	}
+
+	/**
+	*	Gets an argument as the given type.
+	*	@param uiIndex Argument index.
+	*	@param[ out ] value The value.
+	*	@tparam T C++ type. Must have an as::EventArgumentTraits specialization.
+	*	@return true on success, false if the index is out of range or the argument has a different type.
+	*/
+	template<typename T>
+	bool TryGet( const size_t uiIndex, T& value ) const
+	{
+		CASEventArgument arg;
+
+		return GetArgument( uiIndex, arg ) && as::EventArgumentTraits<T>::Get( arg, value );
+	}
+
+	/**
+	*	Gets an argument as the given type.
+	*	@param uiIndex Argument index.
+	*	@tparam T C++ type. Must have an as::EventArgumentTraits specialization.
+	*	@return The value, or a default constructed value if the index is out of range or the argument has a different type.
+	*	@see TryGet
+	*/
+	template<typename T>
+	T Get( const size_t uiIndex ) const
+	{
+		T value = T();
+
+		const bool bSuccess = TryGet( uiIndex, value );
+
+		assert( bSuccess );
+
+		( void ) bSuccess;
+
+		return value;
+	}
+
+	/**
+	*	Copies the arguments into an argument block.
+	*	Only primitive, enum and string arguments can be copied.
+	*	@param[ out ] block Block to add the arguments to.
+	*	@return true on success, false if an argument could not be copied.
+	*/
+	bool ToArgumentBlock( CASArgumentBlock& block ) const;
+
+private:
+	template<typename ARGS>
+	static size_t GetCountImpl( const CASEventArguments& args )
+	{
+		return args.GetCount( *static_cast<const ARGS*>( args.m_pArguments ) );
+	}
+
+	template<typename ARGS>
+	static bool GetArgumentImpl( const CASEventArguments& args, const size_t uiIndex, CASEventArgument& arg )
+	{
+		return args.GetArgument( *static_cast<const ARGS*>( args.m_pArguments ), uiIndex, arg );
+	}
+
+	size_t GetCount( const CASArgumentBlock& args ) const { return args.GetArgumentCount(); }
+
+	size_t GetCount( const CASArguments& args ) const { return args.GetArgumentCount(); }
+
+	size_t GetCount( va_list ) const { return m_pFuncDef ? m_pFuncDef->GetParamCount() : 0; }
+
+	template<typename... ARGS>
+	size_t GetCount( const CASTypedArguments<ARGS...>& ) const { return sizeof...( ARGS ); }
+
+	bool GetArgument( const CASArgumentBlock& args, const size_t uiIndex, CASEventArgument& arg ) const;
+
+	bool GetArgument( const CASArguments& args, const size_t uiIndex, CASEventArgument& arg ) const;
+
+	/**
+	*	Variable arguments can't be accessed by index, so they are converted once, the first time they are accessed.
+	*/
+	bool GetArgument( va_list list, const size_t uiIndex, CASEventArgument& arg ) const;
+
+	template<typename... ARGS>
+	bool GetArgument( const CASTypedArguments<ARGS...>& args, const size_t uiIndex, CASEventArgument& arg ) const
+	{
+		return as::EventArgumentsHelper<sizeof...( ARGS ), ARGS...>::Describe( args.GetArguments(), uiIndex, arg );
+	}
+
+private:
+	const asIScriptFunction* const m_pFuncDef;
+	const void* const m_pArguments;
+	const GetCountFn m_pGetCount;
+	const GetArgumentFn m_pGetArgument;
+
+	//Converted variable arguments. Created on first access.
+	mutable std::unique_ptr<CASArguments> m_VarArgs;
+
+private:
+	CASEventArguments( const CASEventArguments& ) = delete;
+	CASEventArguments& operator=( const CASEventArguments& ) = delete;
+};
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASEVENTARGUMENTS_H
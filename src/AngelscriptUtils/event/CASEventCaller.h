@@ -1,9 +1,17 @@
 #ifndef ANGELSCRIPT_CASEVENTCALLER_H
 #define ANGELSCRIPT_CASEVENTCALLER_H
 
+#include <utility>
+
+#include "AngelscriptUtils/util/ASLogging.h"
+
+#include "AngelscriptUtils/CASModule.h"
+
 #include "CASBaseEventCaller.h"
 
 #include "CASEvent.h"
+#include "CASEventArguments.h"
+#include "CASEventRecorder.h"
 
 /**
 *	@addtogroup ASEvents
@@ -11,22 +19,6 @@
 *	@{
 */
 
-/**
-*	Return codes for functions that hook into an event.
-*/
-enum class HookReturnCode
-{
-	/**
-	*	Continue executing.
-	*/
-	CONTINUE,
-
-	/**
-	*	The function handled the event, stop.
-	*/
-	HANDLED
-};
-
 /**
 *	Result codes for hook invocation.
 */
@@ -50,13 +42,351 @@ enum class HookCallResult
 
 /**
 *	Class that can call CASEvent classes.
+*	A caller that was constructed with a key only calls hooks that were added with that key, and hooks that were added without a key.
+*	A caller that was constructed with a module or descriptor only calls the hooks of that module, or of the modules that use that descriptor.
+*	Otherwise, all hooks are called.
+*	Native listeners are called by all callers except those that target a module or descriptor.
 */
 class CASEventCaller : public CASBaseEventCaller<CASEventCaller, CASEvent, HookCallResult, HookCallResult::FAILED>
 {
 public:
+	/**
+	*	Creates a caller that calls all hooks.
+	*/
+	CASEventCaller() = default;
+
+	/**
+	*	Creates a caller that calls hooks for the given key.
+	*	@param iKey Key.
+	*/
+	explicit CASEventCaller( const int iKey )
+		: m_bKeyed( true )
+		, m_iKey( iKey )
+	{
+	}
+
+	/**
+	*	Creates a caller that only calls hooks that belong to the given module.
+	*	The module's hooks are found with a binary search, so the cost does not depend on the number of hooks in other modules.
+	*	@param module Module. Must remain valid while the caller is in use.
+	*/
+	explicit CASEventCaller( const CASModule& module )
+		: m_pTargetModule( &module )
+	{
+	}
+
+	/**
+	*	Creates a caller that only calls hooks that belong to modules that use the given descriptor.
+	*	@param descriptor Descriptor. Must remain valid while the caller is in use.
+	*/
+	explicit CASEventCaller( const CASModuleDescriptor& descriptor )
+		: m_pTargetDescriptor( &descriptor )
+	{
+	}
+
+	/**
+	*	@return Whether this caller only calls hooks for a specific key.
+	*/
+	bool IsKeyed() const { return m_bKeyed; }
+
+	/**
+	*	@return The key to call hooks for. Only valid if IsKeyed() is true.
+	*/
+	int GetKey() const { return m_iKey; }
+
+	/**
+	*	@return If this caller only calls the hooks of a single module, that module. Otherwise, null.
+	*/
+	const CASModule* GetTargetModule() const { return m_pTargetModule; }
+
+	/**
+	*	@return If this caller only calls the hooks of modules that use a given descriptor, that descriptor. Otherwise, null.
+	*/
+	const CASModuleDescriptor* GetTargetDescriptor() const { return m_pTargetDescriptor; }
+
 	ReturnType_t CallEvent( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, va_list list );
+
+	/**
+	*	Calls the event with arguments that were passed by a script.
+	*	@see CASScriptEvent
+	*/
+	ReturnType_t CallEvent( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, const CASArguments& args );
+
+	/**
+	*	Calls the event with arguments from an argument block.
+	*	@see CASEventManager::PostEvent
+	*/
+	ReturnType_t CallEvent( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, const CASArgumentBlock& args );
+
+	/**
+	*	Calls the event with statically typed arguments. The arguments are not checked against the event's parameters.
+	*	@see CASTypedEvent
+	*/
+	template<typename... ARGS>
+	ReturnType_t CallEvent( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, const CASTypedArguments<ARGS...>& args )
+	{
+		return DispatchEvent( event, pContext, flags, args );
+	}
+
+	/**
+	*	Events without hooks are never called; nothing handled them.
+	*	Events that are being recorded are always called, so the call is recorded.
+	*/
+	bool SkipUnhooked( EventType_t& event, ReturnType_t& result )
+	{
+		if( event.GetRecorder() )
+			return false;
+
+		result = HookCallResult::NONE_HANDLED;
+
+		return true;
+	}
+
+private:
+	template<typename ARGS>
+	ReturnType_t DispatchEvent( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, const ARGS& args );
+
+	/**
+	*	Calls a single hook. Quarantined hooks are skipped, and hooks that keep failing are quarantined.
+	*	@param[ in, out ] returnCode Set to HookReturnCode::HANDLED if the hook handled the event.
+	*	@return Whether the call succeeded.
+	*/
+	template<typename ARGS>
+	bool CallHook( const EventType_t& event, const CASEventHook& hook, CASEventHookState& state, CASContext& ctx, CallFlags_t flags, const ARGS& args, const bool bRecordStats, HookReturnCode& returnCode );
+
+	/**
+	*	@return Whether native listeners with the given priority are called before the hooks of the given module.
+	*	Hooks without a module or without a valid descriptor are called after all listeners.
+	*/
+	static bool IsListenerBefore( const as::ModulePriority_t priority, const CASModule* pModule )
+	{
+		return !pModule || pModule->GetDescriptor().GetDescriptorID() == as::INVALID_DESCRIPTOR_ID || priority >= pModule->GetDescriptor().GetPriority();
+	}
+
+private:
+	bool m_bKeyed = false;
+	int m_iKey = 0;
+
+	const CASModule* m_pTargetModule = nullptr;
+	const CASModuleDescriptor* m_pTargetDescriptor = nullptr;
 };
 
+template<typename ARGS>
+CASEventCaller::ReturnType_t CASEventCaller::DispatchEvent( EventType_t& event, asIScriptContext* pContext, CallFlags_t flags, const ARGS& args )
+{
+	CASContext ctx( *pContext );
+
+	if( auto pRecorder = event.GetRecorder() )
+		pRecorder->Record( event, args );
+
+	const CASEventArguments eventArgs( event.GetFuncDef(), args );
+
+	bool bSuccess = true;
+
+	HookReturnCode returnCode = HookReturnCode::CONTINUE;
+
+	const auto stopMode = event.GetStopMode();
+
+	//Only query the clock if statistics are wanted.
+	const bool bRecordStats = event.AreStatsEnabled();
+
+	CASEventStats::Clock_t::time_point eventStart;
+
+	if( bRecordStats )
+		eventStart = CASEventStats::Clock_t::now();
+
+	//Hooks are already sorted and grouped by module, so no module lookups are needed here.
+	//The published list is not replaced while the event is being triggered, so hooks that add or remove hooks cannot invalidate it.
+	const auto& hooks = event.GetHookList();
+
+	//Native listeners are merged in by priority. Each listener stops propagation like a module whose hook handled the event.
+	const auto& listeners = hooks.GetListeners();
+
+	const size_t uiListenerCount = ( m_pTargetModule || m_pTargetDescriptor ) ? 0 : listeners.size();
+
+	//Set when a nested hook propagated its exception to the calling script. The calling script's context can't be used for any more calls.
+	bool bExceptionPropagated = false;
+
+	auto checkExceptionPropagated = [ & ]()
+	{
+		bExceptionPropagated = ctx.GetContext() == asGetActiveContext() && ctx.GetContext()->GetState() == asEXECUTION_EXCEPTION;
+
+		return bExceptionPropagated;
+	};
+
+	size_t uiListener = 0;
+
+	//Calls the listeners that run before the given module's hooks, or all remaining listeners if the module is null.
+	//Returns whether propagation should stop.
+	auto callListeners = [ & ]( const CASModule* pNextModule )
+	{
+		for( ; uiListener < uiListenerCount; ++uiListener )
+		{
+			if( returnCode == HookReturnCode::HANDLED && stopMode != EventStopMode::CALL_ALL )
+				break;
+
+			const auto& listener = listeners[ uiListener ];
+
+			if( pNextModule && !IsListenerBefore( listener.priority, pNextModule ) )
+				break;
+
+			if( listener.listener( event, eventArgs ) == HookReturnCode::HANDLED )
+				returnCode = HookReturnCode::HANDLED;
+		}
+
+		return returnCode == HookReturnCode::HANDLED && stopMode != EventStopMode::CALL_ALL;
+	};
+
+	if( !m_bKeyed )
+	{
+		auto ranges = std::make_pair( hooks.GetModuleRanges().begin(), hooks.GetModuleRanges().end() );
+
+		if( m_pTargetModule )
+			ranges = hooks.FindModuleRanges( *m_pTargetModule );
+		else if( m_pTargetDescriptor )
+			ranges = hooks.FindDescriptorRanges( *m_pTargetDescriptor );
+
+		for( auto it = ranges.first; it != ranges.second; ++it )
+		{
+			const auto& range = *it;
+
+			//Suspended modules are skipped as a whole.
+			if( range.pModule && !range.pModule->AreHooksEnabled() )
+				continue;
+
+			if( callListeners( range.pModule ) )
+				break;
+
+			for( auto index = range.uiBegin; index < range.uiEnd; ++index )
+			{
+				bSuccess = CallHook( event, hooks.GetHook( index ), hooks.GetHookState( index ), ctx, flags, args, bRecordStats, returnCode ) && bSuccess;
+
+				if( checkExceptionPropagated() )
+					break;
+
+				if( returnCode == HookReturnCode::HANDLED && stopMode == EventStopMode::ON_HANDLED )
+					break;
+			}
+
+			if( bExceptionPropagated )
+				break;
+
+			//A hook in this module handled it, so stop.
+			if( returnCode == HookReturnCode::HANDLED && stopMode != EventStopMode::CALL_ALL )
+				break;
+		}
+	}
+	else
+	{
+		//Merge the hooks without a key with the hooks for this key. Both lists are in dispatch order.
+		const auto& wildcardHooks = hooks.GetWildcardHooks();
+		const auto pKeyedHooks = hooks.FindKeyedHooks( m_iKey );
+
+		const size_t uiWildcardCount = wildcardHooks.size();
+		const size_t uiKeyedCount = pKeyedHooks ? pKeyedHooks->size() : 0;
+
+		size_t uiWildcard = 0;
+		size_t uiKeyed = 0;
+
+		const CASModule* pLastModule = nullptr;
+
+		bool bFirstHook = true;
+
+		while( uiWildcard < uiWildcardCount || uiKeyed < uiKeyedCount )
+		{
+			size_t index;
+
+			if( uiKeyed >= uiKeyedCount || ( uiWildcard < uiWildcardCount && wildcardHooks[ uiWildcard ] < ( *pKeyedHooks )[ uiKeyed ] ) )
+				index = wildcardHooks[ uiWildcard++ ];
+			else
+				index = ( *pKeyedHooks )[ uiKeyed++ ];
+
+			const auto& hook = hooks.GetHook( index );
+
+			if( hook.GetModule() && !hook.GetModule()->AreHooksEnabled() )
+				continue;
+
+			if( bFirstHook || hook.GetModule() != pLastModule )
+			{
+				//A hook in the previous module handled it, so stop.
+				if( returnCode == HookReturnCode::HANDLED && stopMode != EventStopMode::CALL_ALL )
+					break;
+
+				if( callListeners( hook.GetModule() ) )
+					break;
+			}
+
+			pLastModule = hook.GetModule();
+			bFirstHook = false;
+
+			bSuccess = CallHook( event, hook, hooks.GetHookState( index ), ctx, flags, args, bRecordStats, returnCode ) && bSuccess;
+
+			if( checkExceptionPropagated() )
+				break;
+
+			if( returnCode == HookReturnCode::HANDLED && stopMode == EventStopMode::ON_HANDLED )
+				break;
+		}
+	}
+
+	//Listeners with a lower priority than all hooks. Does nothing if a hook stopped propagation.
+	if( !bExceptionPropagated )
+		callListeners( nullptr );
+
+	if( bRecordStats )
+		event.GetStats().Add( CASEventStats::GetElapsedTime( eventStart ), returnCode == HookReturnCode::HANDLED );
+
+	if( !bSuccess )
+		return HookCallResult::FAILED;
+
+	return returnCode == HookReturnCode::HANDLED ? HookCallResult::HANDLED : HookCallResult::NONE_HANDLED;
+}
+
+template<typename ARGS>
+bool CASEventCaller::CallHook( const EventType_t& event, const CASEventHook& hook, CASEventHookState& state, CASContext& ctx, CallFlags_t flags, const ARGS& args, const bool bRecordStats, HookReturnCode& returnCode )
+{
+	if( state.CheckQuarantine() )
+		return true;
+
+	CASFunction func( *hook.GetFunction(), ctx );
+
+	CASEventStats::Clock_t::time_point hookStart;
+
+	if( bRecordStats )
+		hookStart = CASEventStats::Clock_t::now();
+
+	//Exceptions and aborts count as failures, otherwise a hook that always throws would never be quarantined.
+	const auto successCall = as::CallFunction( func, flags, args ) && func.HasFinished();
+
+	if( successCall )
+	{
+		state.RecordSuccess();
+	}
+	else if( const auto uiBackoff = state.RecordFailure( event.GetQuarantineThreshold(), event.GetQuarantineBackoff() ) )
+	{
+		as::log->error( "Event \"{}\": hook \"{}\" failed {} times in a row, quarantined for {} ms",
+						event.GetName(), as::FormatFunctionName( *hook.GetFunction() ), state.GetConsecutiveFailures(), uiBackoff );
+	}
+
+	HookReturnCode hookReturnCode = HookReturnCode::CONTINUE;
+
+	//Only check if a HANDLED value was returned if we're still continuing, or if we need it for statistics.
+	if( successCall && ( returnCode == HookReturnCode::CONTINUE || bRecordStats ) )
+	{
+		//The return type was checked when the event and hook were registered, so it can be read directly.
+		//successCall is only set if the hook finished, so there is a return value to read.
+		hookReturnCode = func.GetReturnValue<HookReturnCode>();
+
+		if( hookReturnCode == HookReturnCode::HANDLED )
+			returnCode = HookReturnCode::HANDLED;
+	}
+
+	if( bRecordStats )
+		state.GetStats().Add( CASEventStats::GetElapsedTime( hookStart ), hookReturnCode == HookReturnCode::HANDLED );
+
+	return successCall;
+}
+
 /**
 *	Registers the HookReturnCode enum.
 *	@param engine Script engine.
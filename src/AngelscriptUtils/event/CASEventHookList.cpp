@@ -0,0 +1,466 @@
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+#include "AngelscriptUtils/CASModule.h"
+
+#include "CASEventHookList.h"
+
+namespace
+{
+/**
+*	Like ModuleLess, but allows null modules. Null modules are sorted last.
+*/
+bool HookModuleLess( const CASModule* pLHS, const CASModule* pRHS )
+{
+	if( !pLHS )
+		return false;
+
+	if( !pRHS )
+		return true;
+
+	return ModuleLess( pLHS, pRHS );
+}
+
+/**
+*	Compares a module range against a descriptor. Ranges without a module are sorted last.
+*/
+bool RangeDescriptorLess( const CASEventModuleRange& range, const CASModuleDescriptor* pDescriptor )
+{
+	return range.pModule && range.pModule->GetDescriptor() < *pDescriptor;
+}
+
+bool DescriptorRangeLess( const CASModuleDescriptor* pDescriptor, const CASEventModuleRange& range )
+{
+	return !range.pModule || *pDescriptor < range.pModule->GetDescriptor();
+}
+}
+
+CASEventHook::CASEventHook( asIScriptFunction& function, CASModule* pModule, const bool bKeyed, const int iKey )
+	: m_pFunction( &function )
+	, m_pModule( pModule )
+	, m_bKeyed( bKeyed )
+	, m_iKey( bKeyed ? iKey : 0 )
+{
+	m_pFunction->AddRef();
+}
+
+CASEventHook::CASEventHook( const CASEventHook& other )
+	: m_pFunction( other.m_pFunction )
+	, m_pModule( other.m_pModule )
+	, m_bKeyed( other.m_bKeyed )
+	, m_iKey( other.m_iKey )
+{
+	if( m_pFunction )
+		m_pFunction->AddRef();
+}
+
+CASEventHook::CASEventHook( CASEventHook&& other )
+	: m_pFunction( other.m_pFunction )
+	, m_pModule( other.m_pModule )
+	, m_bKeyed( other.m_bKeyed )
+	, m_iKey( other.m_iKey )
+{
+	other.m_pFunction = nullptr;
+}
+
+CASEventHook::~CASEventHook()
+{
+	if( m_pFunction )
+		m_pFunction->Release();
+}
+
+CASEventHook& CASEventHook::operator=( const CASEventHook& other )
+{
+	if( this != &other )
+	{
+		if( other.m_pFunction )
+			other.m_pFunction->AddRef();
+
+		if( m_pFunction )
+			m_pFunction->Release();
+
+		m_pFunction = other.m_pFunction;
+		m_pModule = other.m_pModule;
+		m_bKeyed = other.m_bKeyed;
+		m_iKey = other.m_iKey;
+	}
+
+	return *this;
+}
+
+CASEventHook& CASEventHook::operator=( CASEventHook&& other )
+{
+	if( this != &other )
+	{
+		if( m_pFunction )
+			m_pFunction->Release();
+
+		m_pFunction = other.m_pFunction;
+		m_pModule = other.m_pModule;
+		m_bKeyed = other.m_bKeyed;
+		m_iKey = other.m_iKey;
+
+		other.m_pFunction = nullptr;
+	}
+
+	return *this;
+}
+
+uint64_t CASEventHookState::RecordFailure( const uint32_t uiThreshold, const uint32_t uiBackoff )
+{
+	++m_uiConsecutiveFailures;
+
+	if( uiThreshold == 0 )
+		return 0;
+
+	//Hooks that fail right after being released go straight back into quarantine.
+	if( m_uiConsecutiveFailures < uiThreshold && m_uiQuarantineCount == 0 )
+		return 0;
+
+	const uint32_t uiShift = m_uiQuarantineCount < MAX_QUARANTINE_BACKOFF_SHIFT ? m_uiQuarantineCount : MAX_QUARANTINE_BACKOFF_SHIFT;
+
+	const uint64_t uiTime = static_cast<uint64_t>( std::max( uiBackoff, 1u ) ) << uiShift;
+
+	++m_uiQuarantineCount;
+
+	m_bQuarantined = true;
+	m_QuarantineEnd = CASEventStats::Clock_t::now() + std::chrono::milliseconds( uiTime );
+
+	return uiTime;
+}
+
+void CASEventHookState::ReleaseQuarantine()
+{
+	m_uiConsecutiveFailures = 0;
+	m_uiQuarantineCount = 0;
+	m_bQuarantined = false;
+}
+
+CASEventHookList::~CASEventHookList()
+{
+	Clear();
+}
+
+void CASEventHookList::Release() const
+{
+	if( InternalRelease() )
+		delete this;
+}
+
+const CASEventHookList::HookIndices_t* CASEventHookList::FindKeyedHooks( const int iKey ) const
+{
+	assert( !m_bIndicesDirty );
+
+	auto it = m_KeyedHooks.find( iKey );
+
+	if( it != m_KeyedHooks.end() )
+		return &it->second;
+
+	return nullptr;
+}
+
+CASEventHookList::ModuleRangeSpan_t CASEventHookList::FindModuleRanges( const CASModule& module ) const
+{
+	assert( !m_bIndicesDirty );
+
+	auto it = std::lower_bound( m_ModuleRanges.begin(), m_ModuleRanges.end(), &module, []( const CASEventModuleRange& range, const CASModule* pModule )
+	{
+		return HookModuleLess( range.pModule, pModule );
+	} );
+
+	if( it != m_ModuleRanges.end() && it->pModule == &module )
+		return std::make_pair( it, it + 1 );
+
+	return std::make_pair( m_ModuleRanges.end(), m_ModuleRanges.end() );
+}
+
+CASEventHookList::ModuleRangeSpan_t CASEventHookList::FindDescriptorRanges( const CASModuleDescriptor& descriptor ) const
+{
+	assert( !m_bIndicesDirty );
+
+	auto begin = std::lower_bound( m_ModuleRanges.begin(), m_ModuleRanges.end(), &descriptor, RangeDescriptorLess );
+	auto end = std::upper_bound( begin, m_ModuleRanges.end(), &descriptor, DescriptorRangeLess );
+
+	return std::make_pair( begin, end );
+}
+
+bool CASEventHookList::HasModuleHooks( const CASModule* pModule ) const
+{
+	auto it = std::lower_bound( m_Hooks.begin(), m_Hooks.end(), pModule, []( const CASEventHook& hook, const CASModule* pModule )
+	{
+		return HookModuleLess( hook.GetModule(), pModule );
+	} );
+
+	return it != m_Hooks.end() && it->GetModule() == pModule;
+}
+
+bool CASEventHookList::Contains( const asIScriptFunction* pFunction ) const
+{
+	return std::find_if( m_Hooks.begin(), m_Hooks.end(), [ = ]( const CASEventHook& hook )
+	{
+		return hook.GetFunction() == pFunction;
+	} ) != m_Hooks.end();
+}
+
+bool CASEventHookList::Add( asIScriptFunction* pFunction )
+{
+	return AddHook( pFunction, false, 0 );
+}
+
+bool CASEventHookList::Add( asIScriptFunction* pFunction, const int iKey )
+{
+	return AddHook( pFunction, true, iKey );
+}
+
+bool CASEventHookList::AddHook( asIScriptFunction* pFunction, const bool bKeyed, const int iKey )
+{
+	assert( pFunction );
+
+	if( !pFunction )
+		return false;
+
+	auto pModule = GetModuleFromScriptFunction( pFunction );
+
+	//A function can only be hooked once per key, and it can only appear among its module's hooks.
+	auto range = FindModuleHooks( pModule );
+
+	auto it = std::find_if( range.first, range.second, [ = ]( const CASEventHook& hook )
+	{
+		return hook.GetFunction() == pFunction && hook.IsKeyed() == bKeyed && hook.GetKey() == ( bKeyed ? iKey : 0 );
+	} );
+
+	if( it != range.second )
+		return true;
+
+	const auto uiIndex = range.second - m_Hooks.begin();
+
+	//Insert after the last hook of the same module to preserve the order in which hooks were added.
+	m_Hooks.insert( range.second, CASEventHook( *pFunction, pModule, bKeyed, iKey ) );
+	m_HookStates.insert( m_HookStates.begin() + uiIndex, CASEventHookState() );
+
+	m_bIndicesDirty = true;
+
+	return true;
+}
+
+bool CASEventHookList::Remove( asIScriptFunction* pFunction )
+{
+	if( !pFunction )
+		return false;
+
+	return RemoveHooks( [ = ]( const CASEventHook& hook )
+	{
+		return hook.GetFunction() == pFunction;
+	} );
+}
+
+bool CASEventHookList::Remove( asIScriptFunction* pFunction, const int iKey )
+{
+	if( !pFunction )
+		return false;
+
+	auto it = std::find_if( m_Hooks.begin(), m_Hooks.end(), [ = ]( const CASEventHook& hook )
+	{
+		return hook.GetFunction() == pFunction && hook.IsKeyed() && hook.GetKey() == iKey;
+	} );
+
+	if( it == m_Hooks.end() )
+		return false;
+
+	const size_t uiIndex = it - m_Hooks.begin();
+
+	EraseHooks( uiIndex, uiIndex + 1 );
+
+	return true;
+}
+
+void CASEventHookList::RemoveModule( const CASModule* pModule )
+{
+	auto range = FindModuleHooks( pModule );
+
+	if( range.first == range.second )
+		return;
+
+	EraseHooks( range.first - m_Hooks.begin(), range.second - m_Hooks.begin() );
+}
+
+void CASEventHookList::RemoveModules( const std::vector<CASModule*>& modules )
+{
+	if( modules.empty() )
+		return;
+
+	auto sortedModules = modules;
+
+	std::sort( sortedModules.begin(), sortedModules.end() );
+
+	RemoveHooks( [ & ]( const CASEventHook& hook )
+	{
+		return std::binary_search( sortedModules.begin(), sortedModules.end(), hook.GetModule() );
+	} );
+}
+
+void CASEventHookList::Clear()
+{
+	m_Hooks.clear();
+	m_HookStates.clear();
+	m_ModuleRanges.clear();
+	m_WildcardHooks.clear();
+	m_KeyedHooks.clear();
+
+	m_bIndicesDirty = false;
+}
+
+void CASEventHookList::AddListener( const ListenerID_t id, const as::ModulePriority_t priority, NativeEventListener_t&& listener )
+{
+	auto it = std::upper_bound( m_Listeners.begin(), m_Listeners.end(), priority, []( const as::ModulePriority_t priority, const CASEventListener& listener )
+	{
+		return priority > listener.priority;
+	} );
+
+	m_Listeners.insert( it, CASEventListener{ id, priority, std::move( listener ) } );
+}
+
+bool CASEventHookList::RemoveListener( const ListenerID_t id )
+{
+	auto it = std::find_if( m_Listeners.begin(), m_Listeners.end(), [ = ]( const CASEventListener& listener )
+	{
+		return listener.id == id;
+	} );
+
+	if( it == m_Listeners.end() )
+		return false;
+
+	m_Listeners.erase( it );
+
+	return true;
+}
+
+void CASEventHookList::CopyHookStates( const CASEventHookList& other )
+{
+	for( size_t uiIndex = 0; uiIndex < m_Hooks.size(); ++uiIndex )
+	{
+		const auto& hook = m_Hooks[ uiIndex ];
+
+		//Both lists are sorted by module, so only the module's hooks need to be searched.
+		auto begin = std::lower_bound( other.m_Hooks.begin(), other.m_Hooks.end(), hook.GetModule(), []( const CASEventHook& otherHook, const CASModule* pModule )
+		{
+			return HookModuleLess( otherHook.GetModule(), pModule );
+		} );
+
+		auto it = std::find_if( begin, other.m_Hooks.end(), [ & ]( const CASEventHook& otherHook )
+		{
+			return otherHook.GetModule() != hook.GetModule() ||
+				( otherHook.GetFunction() == hook.GetFunction() && otherHook.IsKeyed() == hook.IsKeyed() && otherHook.GetKey() == hook.GetKey() );
+		} );
+
+		if( it != other.m_Hooks.end() && it->GetModule() == hook.GetModule() )
+			m_HookStates[ uiIndex ] = other.m_HookStates[ it - other.m_Hooks.begin() ];
+	}
+}
+
+void CASEventHookList::ResetStats() const
+{
+	for( auto& state : m_HookStates )
+	{
+		state.GetStats().Reset();
+	}
+}
+
+size_t CASEventHookList::GetQuarantinedHookCount() const
+{
+	return static_cast<size_t>( std::count_if( m_HookStates.begin(), m_HookStates.end(), []( const CASEventHookState& state )
+	{
+		return state.IsQuarantined();
+	} ) );
+}
+
+void CASEventHookList::ReleaseQuarantinedHooks() const
+{
+	for( auto& state : m_HookStates )
+	{
+		state.ReleaseQuarantine();
+	}
+}
+
+template<typename PREDICATE>
+bool CASEventHookList::RemoveHooks( PREDICATE predicate )
+{
+	//Compact both arrays in a single pass, keeping the remaining hooks in order.
+	size_t uiKept = 0;
+
+	for( size_t uiIndex = 0; uiIndex < m_Hooks.size(); ++uiIndex )
+	{
+		if( predicate( m_Hooks[ uiIndex ] ) )
+			continue;
+
+		if( uiKept != uiIndex )
+		{
+			m_Hooks[ uiKept ] = std::move( m_Hooks[ uiIndex ] );
+			m_HookStates[ uiKept ] = m_HookStates[ uiIndex ];
+		}
+
+		++uiKept;
+	}
+
+	if( uiKept == m_Hooks.size() )
+		return false;
+
+	EraseHooks( uiKept, m_Hooks.size() );
+
+	return true;
+}
+
+void CASEventHookList::EraseHooks( const size_t uiBegin, const size_t uiEnd )
+{
+	m_Hooks.erase( m_Hooks.begin() + uiBegin, m_Hooks.begin() + uiEnd );
+	m_HookStates.erase( m_HookStates.begin() + uiBegin, m_HookStates.begin() + uiEnd );
+
+	m_bIndicesDirty = true;
+}
+
+std::pair<CASEventHookList::Hooks_t::iterator, CASEventHookList::Hooks_t::iterator> CASEventHookList::FindModuleHooks( const CASModule* pModule )
+{
+	auto begin = std::lower_bound( m_Hooks.begin(), m_Hooks.end(), pModule, []( const CASEventHook& hook, const CASModule* pModule )
+	{
+		return HookModuleLess( hook.GetModule(), pModule );
+	} );
+
+	auto end = std::upper_bound( begin, m_Hooks.end(), pModule, []( const CASModule* pModule, const CASEventHook& hook )
+	{
+		return HookModuleLess( pModule, hook.GetModule() );
+	} );
+
+	return std::make_pair( begin, end );
+}
+
+void CASEventHookList::BuildIndices() const
+{
+	m_ModuleRanges.clear();
+	m_WildcardHooks.clear();
+	m_KeyedHooks.clear();
+
+	for( size_t uiIndex = 0; uiIndex < m_Hooks.size(); ++uiIndex )
+	{
+		const auto& hook = m_Hooks[ uiIndex ];
+
+		//Indices are added in order, so each list is in dispatch order.
+		if( hook.IsKeyed() )
+			m_KeyedHooks[ hook.GetKey() ].push_back( uiIndex );
+		else
+			m_WildcardHooks.push_back( uiIndex );
+
+		auto pModule = hook.GetModule();
+
+		if( m_ModuleRanges.empty() || m_ModuleRanges.back().pModule != pModule )
+		{
+			m_ModuleRanges.push_back( CASEventModuleRange{ uiIndex, uiIndex + 1, pModule } );
+		}
+		else
+		{
+			m_ModuleRanges.back().uiEnd = uiIndex + 1;
+		}
+	}
+
+	m_bIndicesDirty = false;
+}
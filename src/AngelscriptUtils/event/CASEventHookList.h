@@ -0,0 +1,466 @@
+#ifndef ANGELSCRIPT_CASEVENTHOOKLIST_H
+#define ANGELSCRIPT_CASEVENTHOOKLIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <angelscript.h>
+
+#include "AngelscriptUtils/util/CASBaseClass.h"
+
+#include "CASEventListener.h"
+#include "CASEventStats.h"
+
+class CASModule;
+class CASModuleDescriptor;
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+/**
+*	A single hooked function, along with the data needed to dispatch to it.
+*	Hooks are stored by value in hook lists, so dispatching reads them without following a pointer per hook.
+*	Each copy holds a reference to the function.
+*/
+class CASEventHook final
+{
+public:
+	/**
+	*	Constructor.
+	*	@param function The hooked function. Is AddRef'd.
+	*	@param pModule The module that the function belongs to.
+	*	@param bKeyed Whether this hook is only called for calls with a matching key.
+	*	@param iKey If bKeyed is true, the key to match.
+	*/
+	CASEventHook( asIScriptFunction& function, CASModule* pModule, const bool bKeyed = false, const int iKey = 0 );
+
+	CASEventHook( const CASEventHook& other );
+
+	CASEventHook( CASEventHook&& other );
+
+	~CASEventHook();
+
+	CASEventHook& operator=( const CASEventHook& other );
+
+	CASEventHook& operator=( CASEventHook&& other );
+
+	/**
+	*	@return The hooked function. Never null, unless this hook was moved from.
+	*/
+	asIScriptFunction* GetFunction() const { return m_pFunction; }
+
+	/**
+	*	@return The module that the function belongs to. Resolved once when the hook is added.
+	*/
+	CASModule* GetModule() const { return m_pModule; }
+
+	/**
+	*	@return Whether this hook is only called for calls with a matching key. Hooks without a key are called for every call.
+	*/
+	bool IsKeyed() const { return m_bKeyed; }
+
+	/**
+	*	@return The key that this hook matches. Only valid if IsKeyed() is true.
+	*/
+	int GetKey() const { return m_iKey; }
+
+private:
+	asIScriptFunction* m_pFunction;
+
+	CASModule* m_pModule;
+
+	bool m_bKeyed;
+	int m_iKey;
+};
+
+/**
+*	State of a hook that changes as it is called: statistics and quarantine.
+*	Hook lists keep the states in a separate array, indexed the same as the hooks.
+*
+*	Hooks that keep failing are quarantined: they are not called until a back-off period has elapsed.
+*	Each time a hook fails again after being released from quarantine, the back-off period is doubled.
+*/
+class CASEventHookState final
+{
+public:
+	/**
+	*	Maximum number of times that the quarantine back-off period is doubled.
+	*/
+	static const uint32_t MAX_QUARANTINE_BACKOFF_SHIFT = 8;
+
+public:
+	CASEventHookState() = default;
+
+	/**
+	*	@return Call statistics for the hook. Only recorded while statistics are enabled for the event.
+	*/
+	CASEventStats& GetStats() { return m_Stats; }
+
+	/**
+	*	@copydoc GetStats()
+	*/
+	const CASEventStats& GetStats() const { return m_Stats; }
+
+	/**
+	*	@return Number of consecutive calls to the hook that failed.
+	*/
+	uint32_t GetConsecutiveFailures() const { return m_uiConsecutiveFailures; }
+
+	/**
+	*	@return Number of times the hook has been quarantined since it last succeeded.
+	*/
+	uint32_t GetQuarantineCount() const { return m_uiQuarantineCount; }
+
+	/**
+	*	@return Whether the hook is quarantined.
+	*/
+	bool IsQuarantined() const { return m_bQuarantined; }
+
+	/**
+	*	Checks whether the hook should be skipped. Releases the hook from quarantine if its back-off period has elapsed.
+	*	@return true if the hook is quarantined.
+	*/
+	bool CheckQuarantine()
+	{
+		if( !m_bQuarantined )
+			return false;
+
+		if( CASEventStats::Clock_t::now() < m_QuarantineEnd )
+			return true;
+
+		m_bQuarantined = false;
+
+		return false;
+	}
+
+	/**
+	*	Records a successful call.
+	*/
+	void RecordSuccess()
+	{
+		m_uiConsecutiveFailures = 0;
+		m_uiQuarantineCount = 0;
+	}
+
+	/**
+	*	Records a failed call. Quarantines the hook if it has failed too many times in a row,
+	*	or if it fails again after being released from quarantine.
+	*	@param uiThreshold Number of consecutive failures after which the hook is quarantined. 0 disables quarantining.
+	*	@param uiBackoff Base back-off period, in milliseconds.
+	*	@return If the hook was quarantined, the back-off period in milliseconds. Otherwise, 0.
+	*/
+	uint64_t RecordFailure( const uint32_t uiThreshold, const uint32_t uiBackoff );
+
+	/**
+	*	Releases the hook from quarantine, and clears its failure history.
+	*/
+	void ReleaseQuarantine();
+
+private:
+	CASEventStats m_Stats;
+
+	uint32_t m_uiConsecutiveFailures = 0;
+	uint32_t m_uiQuarantineCount = 0;
+	bool m_bQuarantined = false;
+
+	CASEventStats::Clock_t::time_point m_QuarantineEnd;
+};
+
+/**
+*	A contiguous range of hooks that all belong to the same module.
+*/
+struct CASEventModuleRange final
+{
+	/**
+	*	Index of the first hook in the range.
+	*/
+	size_t uiBegin;
+
+	/**
+	*	Index one past the last hook in the range.
+	*/
+	size_t uiEnd;
+
+	/**
+	*	The module that all hooks in this range belong to.
+	*/
+	CASModule* pModule;
+};
+
+/**
+*	Reference counted list of hooks for an event, kept in dispatch order.
+*	Hooks are sorted by module using ModuleLess. Hooks that belong to the same module are kept in the order they were added.
+*	The module ranges are rebuilt once after the list changes, the first time they are needed, so dispatching an event needs no module lookups or sorting
+*	and adding or removing many hooks in a row does not rebuild them each time.
+*	Hooks can be registered with an integer key. Keyed hooks are indexed by key so calls for a given key only visit matching hooks and hooks without a key.
+*	Native listeners are kept in a separate list, sorted by priority. Dispatch merges them with the module ranges.
+*
+*	A list that has been published by an event is never modified while a call holds a reference to it.
+*	Changes made during a call go to a copy, which the event publishes once the outermost call has finished.
+*	Hooks are stored by value, and the whole list is copied on write. Hook states are stored in a parallel array,
+*	so changes to them don't require a copy.
+*/
+class CASEventHookList final : public CASRefCountedBaseClass
+{
+public:
+	typedef std::vector<CASEventHook> Hooks_t;
+	typedef std::vector<CASEventHookState> HookStates_t;
+	typedef std::vector<CASEventModuleRange> ModuleRanges_t;
+	typedef std::vector<CASEventListener> Listeners_t;
+
+	/**
+	*	List of hook indices, in dispatch order.
+	*/
+	typedef std::vector<size_t> HookIndices_t;
+
+	typedef std::unordered_map<int, HookIndices_t> KeyedHooks_t;
+
+	/**
+	*	Span of module ranges, as a [ begin, end ) pair of iterators.
+	*/
+	typedef std::pair<ModuleRanges_t::const_iterator, ModuleRanges_t::const_iterator> ModuleRangeSpan_t;
+
+public:
+	CASEventHookList() = default;
+
+	/**
+	*	Creates a copy of the given list, including the hooks' states.
+	*/
+	CASEventHookList( const CASEventHookList& other ) = default;
+
+	~CASEventHookList();
+
+	void Release() const;
+
+	/**
+	*	@return Number of hooks.
+	*/
+	size_t GetHookCount() const { return m_Hooks.size(); }
+
+	/**
+	*	@return Whether this list contains no hooks.
+	*/
+	bool IsEmpty() const { return m_Hooks.empty(); }
+
+	/**
+	*	@return Whether this list contains any native listeners.
+	*/
+	bool HasListeners() const { return !m_Listeners.empty(); }
+
+	/**
+	*	@return The native listeners, sorted by priority. Listeners with the same priority are kept in the order they were added.
+	*/
+	const Listeners_t& GetListeners() const { return m_Listeners; }
+
+	/**
+	*	Gets a hook by index.
+	*	@param uiIndex Index. Must be smaller than GetHookCount().
+	*	@return Hook.
+	*/
+	const CASEventHook& GetHook( const size_t uiIndex ) const { return m_Hooks[ uiIndex ]; }
+
+	/**
+	*	Gets the state of a hook by index. States can be changed while the list is in use.
+	*	@param uiIndex Index. Must be smaller than GetHookCount().
+	*	@return Hook state.
+	*/
+	CASEventHookState& GetHookState( const size_t uiIndex ) const { return m_HookStates[ uiIndex ]; }
+
+	/**
+	*	@return The list of hooks.
+	*/
+	const Hooks_t& GetHooks() const { return m_Hooks; }
+
+	/**
+	*	@return Whether the indices need to be rebuilt before they can be used.
+	*/
+	bool AreIndicesDirty() const { return m_bIndicesDirty; }
+
+	/**
+	*	Rebuilds the module ranges and the key index if the list has changed since they were last built.
+	*	Must be called before using any of the index accessors. CASBaseEvent::GetHookList does this automatically.
+	*/
+	void UpdateIndices() const
+	{
+		if( m_bIndicesDirty )
+			BuildIndices();
+	}
+
+	/**
+	*	@return The module ranges.
+	*/
+	const ModuleRanges_t& GetModuleRanges() const { assert( !m_bIndicesDirty ); return m_ModuleRanges; }
+
+	/**
+	*	@return Indices of all hooks that have no key.
+	*/
+	const HookIndices_t& GetWildcardHooks() const { assert( !m_bIndicesDirty ); return m_WildcardHooks; }
+
+	/**
+	*	Finds the hooks that were registered with the given key.
+	*	@param iKey Key.
+	*	@return Indices of the hooks, or null if no hooks use this key.
+	*/
+	const HookIndices_t* FindKeyedHooks( const int iKey ) const;
+
+	/**
+	*	Finds the module range for the given module using a binary search.
+	*	@return The range, or an empty span if the module has no hooks.
+	*/
+	ModuleRangeSpan_t FindModuleRanges( const CASModule& module ) const;
+
+	/**
+	*	Finds the module ranges of all modules that use the given descriptor using a binary search.
+	*	Modules are sorted by descriptor first, so these ranges are contiguous.
+	*	@return The ranges, or an empty span if no module that uses the descriptor has hooks.
+	*/
+	ModuleRangeSpan_t FindDescriptorRanges( const CASModuleDescriptor& descriptor ) const;
+
+	/**
+	*	@return Whether any hooks belong to the given module.
+	*/
+	bool HasModuleHooks( const CASModule* pModule ) const;
+
+	/**
+	*	@return Whether the given function is in this list, either with or without a key.
+	*/
+	bool Contains( const asIScriptFunction* pFunction ) const;
+
+	/**
+	*	Adds a function to the list. The function is inserted after all hooks of the same module.
+	*	@param pFunction Function to add. Is AddRef'd.
+	*	@return true if the function was either added or already added before, false otherwise.
+	*/
+	bool Add( asIScriptFunction* pFunction );
+
+	/**
+	*	Adds a function to the list that is only called for calls with the given key.
+	*	A function can be added once for each key, and once without a key.
+	*	@param pFunction Function to add. Is AddRef'd.
+	*	@param iKey Key.
+	*	@return true if the function was either added or already added before, false otherwise.
+	*/
+	bool Add( asIScriptFunction* pFunction, const int iKey );
+
+	/**
+	*	Removes a function from the list, both with and without keys.
+	*	@param pFunction Function to remove.
+	*	@return true if the function was removed, false if it was not in the list.
+	*/
+	bool Remove( asIScriptFunction* pFunction );
+
+	/**
+	*	Removes a function that was added with the given key.
+	*	@param pFunction Function to remove.
+	*	@param iKey Key.
+	*	@return true if the function was removed, false if it was not in the list.
+	*/
+	bool Remove( asIScriptFunction* pFunction, const int iKey );
+
+	/**
+	*	Removes all hooks that belong to the given module.
+	*/
+	void RemoveModule( const CASModule* pModule );
+
+	/**
+	*	Removes all hooks that belong to any of the given modules in a single pass.
+	*/
+	void RemoveModules( const std::vector<CASModule*>& modules );
+
+	/**
+	*	Removes all hooks. Native listeners are not removed, they are owned by the code that added them.
+	*/
+	void Clear();
+
+	/**
+	*	Adds a native listener. The listener is inserted after all listeners with the same or a higher priority.
+	*	@param id Listener ID. Must be unique in this list.
+	*	@param priority Priority.
+	*	@param listener Listener.
+	*/
+	void AddListener( const ListenerID_t id, const as::ModulePriority_t priority, NativeEventListener_t&& listener );
+
+	/**
+	*	Removes a native listener.
+	*	@param id Listener ID.
+	*	@return true if the listener was removed, false if it was not in the list.
+	*/
+	bool RemoveListener( const ListenerID_t id );
+
+	/**
+	*	Copies the states of hooks that are also in the given list. Used to carry hook states over to a new version of a list.
+	*	@param other List to copy states from.
+	*/
+	void CopyHookStates( const CASEventHookList& other );
+
+	/**
+	*	Clears the statistics of all hooks.
+	*/
+	void ResetStats() const;
+
+	/**
+	*	@return Number of hooks that are quarantined.
+	*/
+	size_t GetQuarantinedHookCount() const;
+
+	/**
+	*	Releases all hooks from quarantine.
+	*/
+	void ReleaseQuarantinedHooks() const;
+
+private:
+	/**
+	*	Finds the range of hooks that belong to the given module.
+	*/
+	std::pair<Hooks_t::iterator, Hooks_t::iterator> FindModuleHooks( const CASModule* pModule );
+
+	bool AddHook( asIScriptFunction* pFunction, const bool bKeyed, const int iKey );
+
+	/**
+	*	Removes hooks that match the given predicate, along with their states.
+	*	@return Whether any hooks were removed.
+	*/
+	template<typename PREDICATE>
+	bool RemoveHooks( PREDICATE predicate );
+
+	/**
+	*	Removes the hooks in the given index range, along with their states.
+	*/
+	void EraseHooks( const size_t uiBegin, const size_t uiEnd );
+
+	/**
+	*	Rebuilds the module ranges and the key index.
+	*/
+	void BuildIndices() const;
+
+private:
+	Hooks_t m_Hooks;
+
+	//Indexed the same as m_Hooks.
+	mutable HookStates_t m_HookStates;
+
+	//The indices are a cache of m_Hooks, rebuilt on demand.
+	mutable ModuleRanges_t m_ModuleRanges;
+
+	mutable HookIndices_t m_WildcardHooks;
+
+	mutable KeyedHooks_t m_KeyedHooks;
+
+	mutable bool m_bIndicesDirty = false;
+
+	Listeners_t m_Listeners;
+
+private:
+	CASEventHookList& operator=( const CASEventHookList& ) = delete;
+};
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASEVENTHOOKLIST_H
@@ -0,0 +1,77 @@
+#ifndef ANGELSCRIPT_CASEVENTLISTENER_H
+#define ANGELSCRIPT_CASEVENTLISTENER_H
+
+#include <cstdint>
+#include <functional>
+
+#include "AngelscriptUtils/CASModuleDescriptor.h"
+
+class CASBaseEvent;
+class CASEventArguments;
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+/**
+*	Return codes for functions that hook into an event.
+*/
+enum class HookReturnCode
+{
+	/**
+	*	Continue executing.
+	*/
+	CONTINUE,
+
+	/**
+	*	The function handled the event, stop.
+	*/
+	HANDLED
+};
+
+/**
+*	Identifies a native listener. Returned when the listener is added, and used to remove it.
+*/
+typedef uint32_t ListenerID_t;
+
+/**
+*	Listener ID that never refers to a listener.
+*/
+const ListenerID_t INVALID_LISTENER_ID = 0;
+
+/**
+*	A native listener. Receives the event that was called, and its arguments.
+*	Returning HookReturnCode::HANDLED stops propagation in the same way as a script hook does.
+*/
+typedef std::function<HookReturnCode( CASBaseEvent& event, const CASEventArguments& args )> NativeEventListener_t;
+
+/**
+*	A native listener function, for callers that don't want to use std::function.
+*	@see NativeEventListener_t
+*/
+typedef HookReturnCode ( *NativeEventListenerFn )( CASBaseEvent& event, const CASEventArguments& args, void* pUserData );
+
+/**
+*	A native listener, along with the data needed to dispatch to it.
+*/
+struct CASEventListener final
+{
+	/**
+	*	Unique ID of this listener in its event.
+	*/
+	ListenerID_t id;
+
+	/**
+	*	Listeners are called in the same pass as script hooks, ordered by priority.
+	*	Listeners run before the hooks of modules with the same priority.
+	*/
+	as::ModulePriority_t priority;
+
+	NativeEventListener_t listener;
+};
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASEVENTLISTENER_H
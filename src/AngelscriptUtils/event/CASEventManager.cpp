@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include <sstream>
+#include <utility>
 
 #include "AngelscriptUtils/util/ASUtil.h"
 #include "AngelscriptUtils/util/StringUtils.h"
@@ -8,13 +10,20 @@
 #include "AngelscriptUtils/CASModule.h"
 #include "AngelscriptUtils/CASModuleDescriptor.h"
 
+#include "AngelscriptUtils/wrapper/CASArgumentBlock.h"
+
+#include "CASDeferredEventQueue.h"
 #include "CASEvent.h"
 #include "CASEventCaller.h"
+#include "CASEventRecorder.h"
+#include "CASScriptEvent.h"
 
 #include "CASEventManager.h"
 
-CASEventManager::CASEventManager( asIScriptEngine& engine, const char* const pszNamespace )
+CASEventManager::CASEventManager( asIScriptEngine& engine, const char* const pszNamespace, const uint32_t uiDeferredQueueSize )
 	: m_Engine( engine )
+	, m_DeferredEvents( new CASDeferredEventQueue( uiDeferredQueueSize ) )
+	, m_CoalescedEvents( new CASCoalescedEventQueue( m_DeferredEvents->GetCapacity() ) )
 {
 	assert( pszNamespace );
 
@@ -29,165 +38,268 @@ CASEventManager::~CASEventManager()
 {
 	m_Engine.Release();
 
+	StopRecording();
+
 	UnhookAllFunctions();
+
+	for( auto pEvent : m_Events )
+	{
+		pEvent->SetHookObserver( nullptr );
+	}
 }
 
 CASEvent* CASEventManager::GetEventByIndex( const uint32_t uiIndex )
 {
-	asDWORD uiAccessMask = 0xFFFFFFFF;
+	if( uiIndex >= GetEventCount() )
+		return nullptr;
 
-	auto pCtx = asGetActiveContext();
+	if( !CanAccessEvent( asGetActiveContext(), uiIndex, "GetEventByIndex" ) )
+		return nullptr;
 
-	if( pCtx )
-	{
-		//A script is calling us, get the access mask from the calling module.
-		auto pModule = GetModuleFromScriptContext( pCtx );
+	return m_Events[ uiIndex ];
+}
 
-		if( !pModule )
-		{
-			as::CASCallerInfo info;
+CASEvent* CASEventManager::FindEventByName( const std::string& szName )
+{
+	auto it = m_EventsByName.find( szName );
 
-			as::GetCallerInfo( info, pCtx );
+	if( it == m_EventsByName.end() )
+		return nullptr;
 
-			as::log->critical( "CEventManager::GetEventByIndex: {}({}, {}): Couldn't get module for index \"{}\"!", info.pszSection, info.iLine, info.iColumn, uiIndex );
-			return nullptr;
-		}
+	if( !CanAccessEvent( asGetActiveContext(), it->second, "FindEventByName" ) )
+		return nullptr;
 
-		uiAccessMask = pModule->GetDescriptor().GetAccessMask();
-	}
+	return m_Events[ it->second ];
+}
+
+bool CASEventManager::HookEvent( const std::string& szName, void* pValue, const int iTypeId )
+{
+	auto pEvent = FindEventByName( szName );
 
-	if( uiIndex < GetEventCount() )
+	if( !pEvent )
 	{
-		auto pEvent = m_Events[ uiIndex ];
+		as::CASCallerInfo info;
+
+		as::GetCallerInfo( info );
 
-		if( pEvent->GetAccessMask() & uiAccessMask )
-			return pEvent;
+		as::log->critical( "CEventManager::HookEvent: {}({}, {}): Couldn't find event \"{}\"!", info.pszSection, info.iLine, info.iColumn, szName );
+		return false;
+	}
 
+	return pEvent->Hook( pValue, iTypeId );
+}
+
+void CASEventManager::UnhookEvent( const std::string& szName, void* pValue, const int iTypeId )
+{
+	auto pEvent = FindEventByName( szName );
+
+	if( !pEvent )
+	{
 		as::CASCallerInfo info;
 
-		as::GetCallerInfo( info, pCtx );
+		as::GetCallerInfo( info );
 
-		as::log->debug( "CEventManager::GetEventByIndex: {}({}, {}): Access denied for event \"{}::{}\" (index {})", 
-					 info.pszSection, info.iLine, info.iColumn, 
-					 pEvent->GetCategory(), pEvent->GetName(), uiIndex );
-		return nullptr;
+		as::log->critical( "CEventManager::UnhookEvent: {}({}, {}): Couldn't find event \"{}\"!", info.pszSection, info.iLine, info.iColumn, szName );
 	}
 
-	return nullptr;
+	pEvent->Unhook( pValue, iTypeId );
 }
 
-CASEvent* CASEventManager::FindEventByName( const std::string& szName )
+bool CASEventManager::AddEvent( CASEvent* pEvent )
 {
-	asDWORD uiAccessMask = 0xFFFFFFFF;
+	assert( pEvent );
 
-	auto pCtx = asGetActiveContext();
+	if( !pEvent )
+		return false;
 
-	if( pCtx )
-	{
-		//A script is calling us, get the access mask from the calling module.
-		auto pModule = GetModuleFromScriptContext( pCtx );
+	if( std::find( m_Events.begin(), m_Events.end(), pEvent ) != m_Events.end() )
+		return true;
 
-		if( !pModule )
-		{
-			as::CASCallerInfo info;
+	//Hit maximum number of events.
+	if( GetEventCount() >= UINT32_MAX )
+		return false;
 
-			as::GetCallerInfo( info, pCtx );
+	const auto uiIndex = GetEventCount();
 
-			as::log->critical( "CEventManager::FindEventByName: {}({}, {}): Couldn't get calling module for event \"{}\"!", info.pszSection, info.iLine, info.iColumn, szName );
-			return nullptr;
-		}
+	m_Events.push_back( pEvent );
 
-		uiAccessMask = pModule->GetDescriptor().GetAccessMask();
+	//Modules rebuild their visible events on their next lookup.
+	++m_uiEventsGeneration;
+
+	pEvent->SetHookObserver( this );
+
+	//Index hooks that were added before the event was.
+	for( const auto& range : pEvent->GetHookList().GetModuleRanges() )
+	{
+		if( range.pModule )
+			m_ModuleEvents[ range.pModule ].insert( pEvent );
 	}
 
+	if( m_bStatsEnabled )
+		pEvent->SetStatsEnabled( true );
+
+	pEvent->SetRecorder( m_Recorder.get() );
 
-	auto szNamespace = as::ExtractNamespaceFromName( szName );
-	const auto szEventName = as::ExtractNameFromName( szName );
+	std::string szName;
 
+	if( *pEvent->GetCategory() )
+	{
+		szName = pEvent->GetCategory();
+		szName += "::";
+	}
+
+	szName += pEvent->GetName();
+
+	//If multiple events have the same name, the first one is used.
 	if( !m_szNamespace.empty() )
+		m_EventsByName.emplace( m_szNamespace + "::" + szName, uiIndex );
+
+	m_EventsByName.emplace( std::move( szName ), uiIndex );
+
+	return true;
+}
+
+void CASEventManager::UpdateEventVisibility( CASModule& module ) const
+{
+	const auto uiAccessMask = module.GetDescriptor().GetAccessMask();
+
+	std::vector<bool> visibleEvents( m_Events.size() );
+
+	for( size_t uiIndex = 0; uiIndex < m_Events.size(); ++uiIndex )
 	{
-		const auto szPrefix = m_szNamespace + "::";
+		visibleEvents[ uiIndex ] = ( m_Events[ uiIndex ]->GetAccessMask() & uiAccessMask ) != 0;
+	}
+
+	module.SetEventVisibility( std::move( visibleEvents ), m_uiEventsGeneration );
+}
 
-		const auto index = szNamespace.find( szPrefix );
+CASEvent* CASEventManager::CreateScriptEvent( const std::string& szName, asIScriptFunction& funcDef, const asDWORD accessMask )
+{
+	if( szName.empty() )
+		return nullptr;
+
+	for( const auto& scriptEvent : m_ScriptEvents )
+	{
+		if( scriptEvent->GetName() != szName )
+			continue;
 
-		//If the user specified the event namespace as the namespace, strip it.
-		if( index != std::string::npos )
+		if( !scriptEvent->IsCompatibleWith( funcDef ) )
 		{
-			szNamespace = szNamespace.substr( szPrefix.length() );
+			as::log->error( "CEventManager::CreateEvent: Event \"{}\" already exists with arguments \"{}\"", szName, scriptEvent->GetEvent().GetArguments() );
+			return nullptr;
 		}
+
+		return &scriptEvent->GetEvent();
 	}
 
-	for( auto pEvent : m_Events )
+	//Script events cannot replace events created by the application.
+	if( m_EventsByName.find( szName ) != m_EventsByName.end() )
 	{
-		if( szNamespace == pEvent->GetCategory() && 
-			szEventName == pEvent->GetName() )
-		{
-			//Access mask must allow use of this event.
-			if( pEvent->GetAccessMask() & uiAccessMask )
-				return pEvent;
+		as::log->error( "CEventManager::CreateEvent: An event named \"{}\" already exists", szName );
+		return nullptr;
+	}
 
-			as::CASCallerInfo info;
+	if( funcDef.GetReturnTypeId() != m_Engine.GetTypeIdByDecl( "HookReturnCode" ) )
+	{
+		as::log->error( "CEventManager::CreateEvent: Funcdef \"{}\" for event \"{}\" must return HookReturnCode", funcDef.GetName(), szName );
+		return nullptr;
+	}
 
-			as::GetCallerInfo( info, pCtx );
+	std::unique_ptr<CASScriptEvent> scriptEvent( new CASScriptEvent( szName, funcDef, accessMask ) );
 
-			as::log->debug( "CEventManager::FindEventByName: {}({}, {}): Access denied for event \"{}\"", info.pszSection, info.iLine, info.iColumn, szName );
-			return nullptr;
-		}
-	}
+	if( !AddEvent( &scriptEvent->GetEvent() ) )
+		return nullptr;
+
+	m_ScriptEvents.emplace_back( std::move( scriptEvent ) );
 
-	return nullptr;
+	return &m_ScriptEvents.back()->GetEvent();
 }
 
-bool CASEventManager::HookEvent( const std::string& szName, void* pValue, const int iTypeId )
+CASEvent* CASEventManager::CreateEvent( const std::string& szName, const std::string& szFuncdef )
 {
-	auto pEvent = FindEventByName( szName );
+	auto pCtx = asGetActiveContext();
 
-	if( !pEvent )
-	{
-		as::CASCallerInfo info;
+	if( !pCtx )
+		return nullptr;
 
-		as::GetCallerInfo( info );
+	as::CASCallerInfo info;
 
-		as::log->critical( "CEventManager::HookEvent: {}({}, {}): Couldn't find event \"{}\"!", info.pszSection, info.iLine, info.iColumn, szName );
-		return false;
+	as::GetCallerInfo( info, pCtx );
+
+	//The module may not have been added to the module manager yet, so use the script module and the function's access mask.
+	auto pFunction = as::GetEntryFunction( *pCtx );
+
+	if( !pFunction )
+	{
+		as::log->critical( "CEventManager::CreateEvent: {}({}, {}): Couldn't get calling function for event \"{}\"!", info.pszSection, info.iLine, info.iColumn, szName );
+		return nullptr;
 	}
 
-	return pEvent->Hook( pValue, iTypeId );
-}
+	asIScriptFunction* pFuncDef = nullptr;
 
-void CASEventManager::UnhookEvent( const std::string& szName, void* pValue, const int iTypeId )
-{
-	auto pEvent = FindEventByName( szName );
+	auto pScriptModule = pFunction->GetModule();
 
-	if( !pEvent )
+	auto pTypeInfo = pScriptModule ? pScriptModule->GetTypeInfoByName( szFuncdef.c_str() ) : nullptr;
+
+	if( !pTypeInfo )
+		pTypeInfo = m_Engine.GetTypeInfoByName( szFuncdef.c_str() );
+
+	if( pTypeInfo && ( pTypeInfo->GetFlags() & asOBJ_FUNCDEF ) )
+		pFuncDef = pTypeInfo->GetFuncdefSignature();
+
+	if( !pFuncDef )
 	{
-		as::CASCallerInfo info;
+		as::log->critical( "CEventManager::CreateEvent: {}({}, {}): Couldn't find funcdef \"{}\" for event \"{}\"!", info.pszSection, info.iLine, info.iColumn, szFuncdef, szName );
+		return nullptr;
+	}
 
-		as::GetCallerInfo( info );
+	auto pEvent = CreateScriptEvent( szName, *pFuncDef, pFunction->GetAccessMask() );
 
-		as::log->critical( "CEventManager::UnhookEvent: {}({}, {}): Couldn't find event \"{}\"!", info.pszSection, info.iLine, info.iColumn, szName );
+	if( !pEvent )
+	{
+		as::log->critical( "CEventManager::CreateEvent: {}({}, {}): Couldn't create event \"{}\"!", info.pszSection, info.iLine, info.iColumn, szName );
+		return nullptr;
 	}
 
-	pEvent->Unhook( pValue, iTypeId );
+	return pEvent;
 }
 
-bool CASEventManager::AddEvent( CASEvent* pEvent )
+bool CASEventManager::CanAccessEvent( asIScriptContext* pContext, const uint32_t uiIndex, const char* const pszFunction )
 {
-	assert( pEvent );
+	//Not called by a script, so there are no restrictions.
+	if( !pContext )
+		return true;
 
-	if( !pEvent )
+	//A script is calling us, check whether the calling module can see the event.
+	auto pModule = GetCallingModule( *pContext );
+
+	if( !pModule )
+	{
+		as::CASCallerInfo info;
+
+		as::GetCallerInfo( info, pContext );
+
+		as::log->critical( "CEventManager::{}: {}({}, {}): Couldn't get calling module for event index {}!", pszFunction, info.pszSection, info.iLine, info.iColumn, uiIndex );
 		return false;
+	}
 
-	if( std::find( m_Events.begin(), m_Events.end(), pEvent ) != m_Events.end() )
+	if( pModule->GetEventVisibilityGeneration() != m_uiEventsGeneration )
+		UpdateEventVisibility( *pModule );
+
+	if( pModule->IsEventVisible( uiIndex ) )
 		return true;
 
-	//Hit maximum number of events.
-	if( GetEventCount() >= UINT32_MAX )
-		return false;
+	as::CASCallerInfo info;
 
-	m_Events.push_back( pEvent );
+	as::GetCallerInfo( info, pContext );
 
-	return true;
+	auto pEvent = m_Events[ uiIndex ];
+
+	as::log->debug( "CEventManager::{}: {}({}, {}): Access denied for event \"{}::{}\" (index {})",
+					pszFunction, info.pszSection, info.iLine, info.iColumn,
+					pEvent->GetCategory(), pEvent->GetName(), uiIndex );
+
+	return false;
 }
 
 void CASEventManager::RegisterEvents( asIScriptEngine& engine )
@@ -248,18 +360,70 @@ void CASEventManager::UnhookModuleFunctions( CASModule* pModule )
 	if( !pModule )
 		return;
 
-	for( auto pEvent : m_Events )
+	auto it = m_ModuleEvents.find( pModule );
+
+	if( it == m_ModuleEvents.end() )
+		return;
+
+	//Removing hooks updates the index through OnModuleHooksChanged, so iterate over a copy.
+	//Events that refuse the removal keep their entry, so the hooks can still be found and removed later.
+	const auto events = it->second;
+
+	for( auto pEvent : events )
 	{
 		pEvent->RemoveFunctionsOfModule( pModule );
 	}
 }
 
+void CASEventManager::UnhookModuleFunctions( const std::vector<CASModule*>& modules )
+{
+	std::unordered_set<CASBaseEvent*> events;
+
+	for( auto pModule : modules )
+	{
+		auto it = m_ModuleEvents.find( pModule );
+
+		if( it == m_ModuleEvents.end() )
+			continue;
+
+		//Removing hooks updates the index through OnModuleHooksChanged, so only the events are collected here.
+		events.insert( it->second.begin(), it->second.end() );
+	}
+
+	for( auto pEvent : events )
+	{
+		pEvent->RemoveFunctionsOfModules( modules );
+	}
+}
+
 void CASEventManager::UnhookAllFunctions()
 {
 	for( auto pEvent : m_Events )
 	{
 		pEvent->RemoveAllFunctions();
 	}
+
+	m_ModuleEvents.clear();
+}
+
+void CASEventManager::OnModuleHooksChanged( CASBaseEvent& event, CASModule* pModule )
+{
+	if( event.HasFunctionsOfModule( pModule ) )
+	{
+		m_ModuleEvents[ pModule ].insert( &event );
+	}
+	else
+	{
+		auto it = m_ModuleEvents.find( pModule );
+
+		if( it == m_ModuleEvents.end() )
+			return;
+
+		it->second.erase( &event );
+
+		if( it->second.empty() )
+			m_ModuleEvents.erase( it );
+	}
 }
 
 void CASEventManager::DumpHookedFunctions() const
@@ -270,6 +434,201 @@ void CASEventManager::DumpHookedFunctions() const
 	}
 }
 
+void CASEventManager::SetStatsEnabled( const bool bEnabled )
+{
+	m_bStatsEnabled = bEnabled;
+
+	for( auto pEvent : m_Events )
+	{
+		pEvent->SetStatsEnabled( bEnabled );
+	}
+}
+
+void CASEventManager::ResetStats()
+{
+	for( auto pEvent : m_Events )
+	{
+		pEvent->ResetStats();
+	}
+}
+
+std::string CASEventManager::GetStatsReport() const
+{
+	auto events = m_Events;
+
+	events.erase( std::remove_if( events.begin(), events.end(), []( const CASEvent* pEvent )
+	{
+		return pEvent->GetStats().uiCallCount == 0;
+	} ), events.end() );
+
+	std::sort( events.begin(), events.end(), []( const CASEvent* pLHS, const CASEvent* pRHS )
+	{
+		return pLHS->GetStats().uiTotalTime > pRHS->GetStats().uiTotalTime;
+	} );
+
+	std::ostringstream stream;
+
+	auto printStats = [ &stream ]( const CASEventStats& stats )
+	{
+		stream << "calls " << stats.uiCallCount
+			<< ", total " << stats.GetTotalTimeMs() << " ms"
+			<< ", max " << stats.GetMaxTimeMs() << " ms"
+			<< ", handled " << ( stats.GetHandledRate() * 100 ) << "%\n";
+	};
+
+	//Indices of the hooks that were called.
+	std::vector<size_t> hooks;
+
+	for( auto pEvent : events )
+	{
+		stream << "Event \"";
+
+		if( !m_szNamespace.empty() )
+			stream << m_szNamespace << "::";
+
+		if( *pEvent->GetCategory() )
+			stream << pEvent->GetCategory() << "::";
+
+		stream << pEvent->GetName() << "\": ";
+
+		printStats( pEvent->GetStats() );
+
+		hooks.clear();
+
+		const auto& hookList = pEvent->GetHookList();
+
+		for( size_t uiIndex = 0; uiIndex < hookList.GetHookCount(); ++uiIndex )
+		{
+			if( hookList.GetHookState( uiIndex ).GetStats().uiCallCount > 0 )
+				hooks.push_back( uiIndex );
+		}
+
+		std::sort( hooks.begin(), hooks.end(), [ & ]( const size_t uiLHS, const size_t uiRHS )
+		{
+			return hookList.GetHookState( uiLHS ).GetStats().uiTotalTime > hookList.GetHookState( uiRHS ).GetStats().uiTotalTime;
+		} );
+
+		for( auto uiIndex : hooks )
+		{
+			const auto& hook = hookList.GetHook( uiIndex );
+
+			stream << "\tModule \"" << ( hook.GetModule() ? hook.GetModule()->GetModuleName() : "Unknown" ) << "\", \""
+				<< as::FormatFunctionName( *hook.GetFunction() ) << "\": ";
+
+			printStats( hookList.GetHookState( uiIndex ).GetStats() );
+		}
+	}
+
+	return stream.str();
+}
+
+void CASEventManager::DumpStatsReport() const
+{
+	as::log->info( "Event statistics:\n{}", GetStatsReport() );
+}
+
+bool CASEventManager::PostEvent( CASEvent& event, CASArgumentBlock&& arguments )
+{
+	return m_DeferredEvents->Post( event, std::move( arguments ) );
+}
+
+bool CASEventManager::PostEvent( CASEvent& event, const uint64_t uiKey, CASArgumentBlock&& arguments )
+{
+	if( !event.IsCoalesced() )
+		return m_DeferredEvents->Post( event, std::move( arguments ) );
+
+	return m_CoalescedEvents->Post( event, uiKey, std::move( arguments ) );
+}
+
+uint32_t CASEventManager::GetDroppedDeferredEventCount() const
+{
+	return m_DeferredEvents->GetDroppedCount() + m_CoalescedEvents->GetDroppedCount();
+}
+
+uint32_t CASEventManager::GetMergedDeferredEventCount() const
+{
+	return m_CoalescedEvents->GetMergedCount();
+}
+
+uint32_t CASEventManager::ProcessDeferredEvents()
+{
+	//Don't acquire a context if there's nothing to do.
+	if( m_DeferredEvents->IsEmpty() && m_CoalescedEvents->IsEmpty() )
+		return 0;
+
+	auto pContext = m_Engine.RequestContext();
+
+	//Nothing has been taken out of the queues yet, so the events are delivered next time.
+	if( !pContext )
+	{
+		as::log->error( "CASEventManager::ProcessDeferredEvents: Couldn't acquire a context; events remain queued" );
+		return 0;
+	}
+
+	//Taken before any events are called, so coalesced events posted by hooks are delivered next time.
+	//Entries over budget stay pending, and can still be merged into.
+	CASCoalescedEventQueue::Events_t coalescedEvents;
+
+	m_CoalescedEvents->TakeEvents( coalescedEvents, m_uiDeferredEventBudget );
+
+	CASEventCaller caller;
+
+	//Coalesced entries count towards the budget.
+	uint32_t uiCount = static_cast<uint32_t>( coalescedEvents.size() );
+
+	CASDeferredEvent event;
+
+	while( ( m_uiDeferredEventBudget == 0 || uiCount < m_uiDeferredEventBudget ) && m_DeferredEvents->Pop( event ) )
+	{
+		++uiCount;
+
+		caller.CallArgs( *event.pEvent, pContext, CallFlag::NONE, event.arguments );
+	}
+
+	for( const auto& coalescedEvent : coalescedEvents )
+	{
+		caller.CallArgs( *coalescedEvent.pEvent, pContext, CallFlag::NONE, coalescedEvent.arguments );
+	}
+
+	m_Engine.ReturnContext( pContext );
+
+	return uiCount;
+}
+
+bool CASEventManager::StartRecording( const std::string& szFilename )
+{
+	StopRecording();
+
+	std::unique_ptr<CASEventRecorder> recorder( new CASEventRecorder( szFilename ) );
+
+	if( !recorder->IsOpen() )
+		return false;
+
+	m_Recorder = std::move( recorder );
+
+	for( auto pEvent : m_Events )
+	{
+		pEvent->SetRecorder( m_Recorder.get() );
+	}
+
+	return true;
+}
+
+void CASEventManager::StopRecording()
+{
+	if( !m_Recorder )
+		return;
+
+	for( auto pEvent : m_Events )
+	{
+		pEvent->SetRecorder( nullptr );
+	}
+
+	as::log->info( "CEventManager: Recorded {} event calls, {} calls could not be recorded", m_Recorder->GetRecordedCount(), m_Recorder->GetUnrecordableCount() );
+
+	m_Recorder.reset();
+}
+
 static void RegisterScriptCEventManager( asIScriptEngine& engine )
 {
 	const char* const pszObjectName = "CEventManager";
@@ -295,6 +654,26 @@ static void RegisterScriptCEventManager( asIScriptEngine& engine )
 	engine.RegisterObjectMethod(
 		pszObjectName, "void UnhookEvent(const string& in szName, ?& in pFunction)",
 		asMETHOD( CASEventManager, UnhookEvent ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "CScriptEvent@ CreateEvent(const string& in szName, const string& in szFuncdef)",
+		asMETHOD( CASEventManager, CreateEvent ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "bool AreStatsEnabled() const",
+		asMETHOD( CASEventManager, AreStatsEnabled ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "void SetStatsEnabled(const bool bEnabled)",
+		asMETHOD( CASEventManager, SetStatsEnabled ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "void ResetStats()",
+		asMETHOD( CASEventManager, ResetStats ), asCALL_THISCALL );
+
+	engine.RegisterObjectMethod(
+		pszObjectName, "string GetStatsReport() const",
+		asMETHOD( CASEventManager, GetStatsReport ), asCALL_THISCALL );
 }
 
 void RegisterScriptEventAPI( asIScriptEngine& engine )
@@ -302,8 +681,10 @@ void RegisterScriptEventAPI( asIScriptEngine& engine )
 	const asDWORD accessMask = engine.SetDefaultAccessMask( 0xFFFFFFFF );
 
 	RegisterScriptHookReturnCode( engine );
+	RegisterScriptCEventStats( engine );
 	RegisterScriptCBaseEvent( engine );
 	RegisterScriptCEvent( engine );
+	RegisterScriptCScriptEvent( engine );
 	RegisterScriptCEventManager( engine );
 
 	engine.SetDefaultAccessMask( accessMask );
@@ -2,14 +2,24 @@
 #define ANGELSCRIPT_CASEVENTMANAGER_H
 
 #include <cstdint>
+#include <memory>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include <angelscript.h>
 
+#include "IASEventHookObserver.h"
+
 class asIScriptEngine;
+class CASArgumentBlock;
+class CASCoalescedEventQueue;
+class CASDeferredEventQueue;
+class CASEventRecorder;
 class CASModule;
 class CASEvent;
+class CASScriptEvent;
 
 /**
 *	@addtogroup ASEvents
@@ -21,18 +31,37 @@ class CASEvent;
 *	Manages a list of global events.
 *	Can store a maximum of UINT32_MAX events.
 */
-class CASEventManager final
+class CASEventManager final : public IASEventHookObserver
 {
 private:
 	typedef std::vector<CASEvent*> Events_t;
 
+	typedef std::vector<std::unique_ptr<CASScriptEvent>> ScriptEvents_t;
+
+	/**
+	*	Maps fully qualified event names to event indices.
+	*/
+	typedef std::unordered_map<std::string, uint32_t> EventsByName_t;
+
+	/**
+	*	Maps modules to the events that they have hooked into.
+	*/
+	typedef std::unordered_map<const CASModule*, std::unordered_set<CASBaseEvent*>> ModuleEvents_t;
+
+public:
+	/**
+	*	Default maximum number of deferred events that can be queued.
+	*/
+	static const uint32_t DEFAULT_DEFERRED_QUEUE_SIZE = 1024;
+
 public:
 	/**
 	*	Constructor.
 	*	@param engine Engine.
 	*	@param pszNamespace Namespace to register events in. Can be an empty string, in which case no namespace is used.
+	*	@param uiDeferredQueueSize Maximum number of deferred events that can be queued. Coalesced events are queued separately, with the same limit.
 	*/
-	CASEventManager( asIScriptEngine& engine, const char* const pszNamespace = "" );
+	CASEventManager( asIScriptEngine& engine, const char* const pszNamespace = "", const uint32_t uiDeferredQueueSize = DEFAULT_DEFERRED_QUEUE_SIZE );
 
 	/**
 	*	Destructor.
@@ -92,6 +121,38 @@ public:
 	*/
 	bool AddEvent( CASEvent* pEvent );
 
+	/**
+	*	Creates an event that is declared by a script, or returns the existing event with that name.
+	*	The event is owned by this manager and remains valid until the manager is destroyed.
+	*	@param szName Name of the event. Must not be used by an event that was not created by this method.
+	*	@param funcDef Funcdef that describes the hook signature. Must return HookReturnCode.
+	*	@param accessMask Access mask. Which module types the event is available to.
+	*	@return If the event was created, or an event with the same name and a compatible signature already exists, the event. Otherwise, null.
+	*/
+	CASEvent* CreateScriptEvent( const std::string& szName, asIScriptFunction& funcDef, const asDWORD accessMask );
+
+	/**
+	*	Script version of CreateScriptEvent. Looks up the funcdef in the calling module, and uses the calling module's access mask.
+	*	Meant to be called from a global variable initializer, so the event exists by the time the module has been built:
+	*	CScriptEvent@ g_OnSpawn = g_EventManager.CreateEvent( "OnSpawn", "SpawnHook" );
+	*	@param szName Name of the event.
+	*	@param szFuncdef Name of the funcdef that describes the hook signature.
+	*	@return If the event was created, or an event with the same name and a compatible signature already exists, the event. Otherwise, null.
+	*/
+	CASEvent* CreateEvent( const std::string& szName, const std::string& szFuncdef );
+
+	/**
+	*	@return The current generation of the event list. Incremented whenever an event is added.
+	*/
+	uint32_t GetEventsGeneration() const { return m_uiEventsGeneration; }
+
+	/**
+	*	Rebuilds the set of events that are visible to the given module, based on its descriptor's access mask.
+	*	Called when a module is added. Modules are also updated on their next event lookup after events have been added.
+	*	@param module Module.
+	*/
+	void UpdateEventVisibility( CASModule& module ) const;
+
 	/**
 	*	Registers this class instance and all events.
 	*/
@@ -99,10 +160,18 @@ public:
 
 	/**
 	*	Unhooks all functions that are part of the given module.
+	*	Only events that the module has hooked into are visited.
 	*	@param pModule Module.
 	*/
 	void UnhookModuleFunctions( CASModule* pModule );
 
+	/**
+	*	Unhooks all functions that are part of any of the given modules.
+	*	Each affected event is updated once, regardless of how many of the modules hooked into it.
+	*	@param modules Modules.
+	*/
+	void UnhookModuleFunctions( const std::vector<CASModule*>& modules );
+
 	/**
 	*	Unhooks all functions.
 	*/
@@ -113,6 +182,124 @@ public:
 	*/
 	void DumpHookedFunctions() const;
 
+	/**
+	*	@return Whether call statistics are recorded for all events.
+	*/
+	bool AreStatsEnabled() const { return m_bStatsEnabled; }
+
+	/**
+	*	Sets whether call statistics are recorded for all events, including events added later.
+	*/
+	void SetStatsEnabled( const bool bEnabled );
+
+	/**
+	*	Clears the statistics of all events and their hooks.
+	*/
+	void ResetStats();
+
+	/**
+	*	Creates a report of all events that have been called while statistics were enabled.
+	*	Events are sorted by total execution time, followed by their hooks sorted the same way.
+	*	@return The report.
+	*/
+	std::string GetStatsReport() const;
+
+	/**
+	*	Dumps the statistics report to the log.
+	*	@see GetStatsReport
+	*/
+	void DumpStatsReport() const;
+
+	/**
+	*	Posts an event to be called by the next ProcessDeferredEvents call.
+	*	Thread-safe; this can be called from any thread.
+	*	@param event Event to post.
+	*	@param arguments Arguments to pass to the event.
+	*	@return true if the event was queued, false if the queue is full.
+	*/
+	bool PostEvent( CASEvent& event, CASArgumentBlock&& arguments );
+
+	/**
+	*	Posts an event with a coalescing key. If the event is coalesced, posts with the same key are merged
+	*	until the next ProcessDeferredEvents call, which delivers them once. Otherwise, this is the same as PostEvent( event, arguments ).
+	*	Thread-safe; this can be called from any thread.
+	*	@param event Event to post.
+	*	@param uiKey Coalescing key, e.g. an entity index.
+	*	@param arguments Arguments to pass to the event.
+	*	@return true if the event was queued or merged, false if the queue is full.
+	*	Whether the event is coalesced must not change while it can be posted, see CASEvent::SetCoalesced.
+	*	@see CASEvent::SetCoalesced
+	*/
+	bool PostEvent( CASEvent& event, const uint64_t uiKey, CASArgumentBlock&& arguments );
+
+	/**
+	*	@return Maximum number of deferred events that are called per ProcessDeferredEvents call. 0 means no limit.
+	*/
+	uint32_t GetDeferredEventBudget() const { return m_uiDeferredEventBudget; }
+
+	/**
+	*	Sets the maximum number of deferred events that are called per ProcessDeferredEvents call. 0 means no limit.
+	*	Coalesced entries count towards the budget. Events and entries over budget remain queued until the next call.
+	*/
+	void SetDeferredEventBudget( const uint32_t uiBudget )
+	{
+		m_uiDeferredEventBudget = uiBudget;
+	}
+
+	/**
+	*	@return Number of deferred events, including coalesced events, that were dropped because the queue was full.
+	*/
+	uint32_t GetDroppedDeferredEventCount() const;
+
+	/**
+	*	@return Number of coalesced posts that were merged into a pending post instead of being delivered separately.
+	*/
+	uint32_t GetMergedDeferredEventCount() const;
+
+	/**
+	*	Calls posted events, up to the deferred event budget. All events are called using a single context.
+	*	Coalesced entries are delivered after the other events. They are taken first, so they are not starved by a steady stream of other events.
+	*	Must be called from the thread that runs scripts.
+	*	@return Number of events that were called.
+	*/
+	uint32_t ProcessDeferredEvents();
+
+	/**
+	*	@return Whether event calls are being recorded.
+	*/
+	bool IsRecording() const { return m_Recorder != nullptr; }
+
+	/**
+	*	@return The active recorder, or null if calls are not being recorded.
+	*/
+	CASEventRecorder* GetRecorder() const { return m_Recorder.get(); }
+
+	/**
+	*	Starts recording all calls to all events, including events added later, to a trace file.
+	*	Events without hooks are still dispatched while recording so their calls are recorded as well.
+	*	Stops any recording that is in progress.
+	*	@param szFilename Name of the trace file.
+	*	@return true if recording started, false if the file could not be opened.
+	*	@see CASEventReplayer
+	*/
+	bool StartRecording( const std::string& szFilename );
+
+	/**
+	*	Stops recording and closes the trace file.
+	*/
+	void StopRecording();
+
+	void OnModuleHooksChanged( CASBaseEvent& event, CASModule* pModule ) override;
+
+private:
+	/**
+	*	Checks whether the script that is calling into the manager can access an event.
+	*	@param pContext Active context. If null, the call came from C++ and all events are accessible.
+	*	@param uiIndex Event index.
+	*	@param pszFunction Name of the calling method, for logging.
+	*/
+	bool CanAccessEvent( asIScriptContext* pContext, const uint32_t uiIndex, const char* const pszFunction );
+
 private:
 	asIScriptEngine& m_Engine;
 
@@ -120,6 +307,27 @@ private:
 
 	Events_t m_Events;
 
+	//Events declared by scripts. Also listed in m_Events.
+	ScriptEvents_t m_ScriptEvents;
+
+	//Contains both "<Category>::<Name>" and "<Namespace>::<Category>::<Name>" for each event.
+	EventsByName_t m_EventsByName;
+
+	uint32_t m_uiEventsGeneration = 1;
+
+	//Which events each module has hooked into. Kept up to date by the events.
+	ModuleEvents_t m_ModuleEvents;
+
+	std::unique_ptr<CASDeferredEventQueue> m_DeferredEvents;
+
+	std::unique_ptr<CASCoalescedEventQueue> m_CoalescedEvents;
+
+	std::unique_ptr<CASEventRecorder> m_Recorder;
+
+	uint32_t m_uiDeferredEventBudget = 0;
+
+	bool m_bStatsEnabled = false;
+
 private:
 	CASEventManager( const CASEventManager& ) = delete;
 	CASEventManager& operator=( const CASEventManager& ) = delete;
@@ -0,0 +1,222 @@
+#include <cassert>
+#include <cstring>
+
+#include <angelscript.h>
+
+#include "AngelscriptUtils/util/ASLogging.h"
+
+#include "AngelscriptUtils/wrapper/CASArguments.h"
+
+#include "CASEvent.h"
+
+#include "CASEventRecorder.h"
+
+namespace
+{
+//Flush to disk once this much has been buffered.
+const size_t BUFFER_FLUSH_SIZE = 64 * 1024;
+}
+
+namespace as
+{
+namespace EventTrace
+{
+size_t GetPrimitiveSize( const int iTypeId )
+{
+	switch( iTypeId )
+	{
+	case asTYPEID_BOOL:
+	case asTYPEID_INT8:
+	case asTYPEID_UINT8:	return 1;
+	case asTYPEID_INT16:
+	case asTYPEID_UINT16:	return 2;
+	case asTYPEID_INT32:
+	case asTYPEID_UINT32:
+	case asTYPEID_FLOAT:	return 4;
+	case asTYPEID_INT64:
+	case asTYPEID_UINT64:
+	case asTYPEID_DOUBLE:	return 8;
+
+	default:				return 0;
+	}
+}
+}
+}
+
+CASEventRecorder::CASEventRecorder( const std::string& szFilename )
+	: m_File( szFilename, std::ios::binary | std::ios::trunc )
+	, m_Start( CASEventStats::Clock_t::now() )
+{
+	if( !m_File.is_open() )
+	{
+		as::log->error( "CASEventRecorder: Couldn't open trace file \"{}\"", szFilename );
+		return;
+	}
+
+	m_Buffer.reserve( BUFFER_FLUSH_SIZE );
+
+	Write( "ASET", 4 );
+	Write( as::EventTrace::VERSION );
+}
+
+CASEventRecorder::~CASEventRecorder()
+{
+	Flush();
+}
+
+void CASEventRecorder::Record( const CASEvent& event, const CASArgumentBlock& args )
+{
+	if( !m_File.is_open() )
+		return;
+
+	const auto uiIndex = GetEventIndex( event );
+
+	const auto uiTime = CASEventStats::GetElapsedTime( m_Start );
+
+	Write( as::EventTrace::RECORD_CALL );
+	Write( uiIndex );
+	Write( uiTime );
+	Write( static_cast<uint8_t>( args.GetArgumentCount() ) );
+
+	for( size_t uiArg = 0; uiArg < args.GetArgumentCount(); ++uiArg )
+	{
+		if( args.IsString( uiArg ) )
+		{
+			Write( as::EventTrace::TYPEID_STRING );
+			WriteString( args.GetString( uiArg ) );
+		}
+		else
+		{
+			const int iTypeId = args.GetTypeId( uiArg );
+
+			Write( static_cast<uint8_t>( iTypeId ) );
+
+			//All union members start at the same address, so this writes the value regardless of byte order.
+			Write( &args.GetValue( uiArg ), as::EventTrace::GetPrimitiveSize( iTypeId ) );
+		}
+	}
+
+	++m_uiRecordedCount;
+
+	if( m_Buffer.size() >= BUFFER_FLUSH_SIZE )
+		Flush();
+}
+
+void CASEventRecorder::Record( const CASEvent& event, const CASArguments& args )
+{
+	auto pFuncDef = event.GetFuncDef();
+
+	CASArgumentBlock block;
+
+	for( const auto& arg : args.GetArgumentList() )
+	{
+		bool bAdded = false;
+
+		switch( arg.GetArgumentType() )
+		{
+		case ArgType::PRIMITIVE:
+			{
+				bAdded = as::EventTrace::GetPrimitiveSize( arg.GetTypeId() ) > 0 && block.AddPrimitive( arg.GetTypeId(), arg.GetArgumentValue() );
+				break;
+			}
+
+		case ArgType::ENUM:
+			{
+				bAdded = block.Add( static_cast<int32_t>( arg.GetArgumentValue().dword ) );
+				break;
+			}
+
+		case ArgType::VALUE:
+		case ArgType::REF:
+			{
+				auto pType = pFuncDef ? pFuncDef->GetEngine()->GetTypeInfoById( arg.GetTypeId() ) : nullptr;
+
+				if( pType && strcmp( pType->GetName(), "string" ) == 0 && !( arg.GetTypeId() & asTYPEID_OBJHANDLE ) )
+					bAdded = block.Add( *reinterpret_cast<const std::string*>( arg.GetArgumentValue().pValue ) );
+
+				break;
+			}
+
+		default: break;
+		}
+
+		if( !bAdded )
+		{
+			++m_uiUnrecordableCount;
+			return;
+		}
+	}
+
+	Record( event, block );
+}
+
+void CASEventRecorder::Record( const CASEvent& event, va_list list )
+{
+	auto pFuncDef = event.GetFuncDef();
+
+	if( !pFuncDef )
+	{
+		++m_uiUnrecordableCount;
+		return;
+	}
+
+	//Copies the list, so the caller can still use it.
+	CASArguments args( *pFuncDef, list );
+
+	if( args.GetArgumentCount() != pFuncDef->GetParamCount() )
+	{
+		++m_uiUnrecordableCount;
+		return;
+	}
+
+	Record( event, args );
+}
+
+void CASEventRecorder::Flush()
+{
+	if( m_Buffer.empty() )
+		return;
+
+	m_File.write( reinterpret_cast<const char*>( m_Buffer.data() ), m_Buffer.size() );
+	m_File.flush();
+
+	m_Buffer.clear();
+}
+
+uint32_t CASEventRecorder::GetEventIndex( const CASEvent& event )
+{
+	auto result = m_EventIndices.emplace( &event, static_cast<uint32_t>( m_EventIndices.size() ) );
+
+	if( result.second )
+	{
+		std::string szName;
+
+		if( *event.GetCategory() )
+		{
+			szName = event.GetCategory();
+			szName += "::";
+		}
+
+		szName += event.GetName();
+
+		Write( as::EventTrace::RECORD_EVENT );
+		Write( result.first->second );
+		WriteString( szName );
+		WriteString( event.GetArguments() );
+	}
+
+	return result.first->second;
+}
+
+void CASEventRecorder::Write( const void* pData, const size_t uiSize )
+{
+	auto pBytes = reinterpret_cast<const uint8_t*>( pData );
+
+	m_Buffer.insert( m_Buffer.end(), pBytes, pBytes + uiSize );
+}
+
+void CASEventRecorder::WriteString( const std::string& szString )
+{
+	Write( static_cast<uint32_t>( szString.size() ) );
+	Write( szString.data(), szString.size() );
+}
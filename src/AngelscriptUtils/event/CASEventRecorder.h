@@ -0,0 +1,267 @@
+#ifndef ANGELSCRIPT_CASEVENTRECORDER_H
+#define ANGELSCRIPT_CASEVENTRECORDER_H
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "AngelscriptUtils/wrapper/CASArgumentBlock.h"
+#include "AngelscriptUtils/wrapper/CASTypedArguments.h"
+
+#include "CASEventStats.h"
+
+class CASArguments;
+class CASEvent;
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+namespace as
+{
+/**
+*	Event trace file format. All values are stored in the byte order of the machine that recorded the trace.
+*
+*	Header: the 4 byte magic "ASET", followed by the uint32 version.
+*	The header is followed by records, each starting with a uint8 record type:
+*	EVENT: uint32 event index, event name, argument declaration. Written once per event, before its first call.
+*	CALL: uint32 event index, uint64 time since recording started in nanoseconds, uint8 argument count, arguments.
+*
+*	Strings are stored as a uint32 length followed by the characters.
+*	Each argument is stored as a uint8 type id, followed by the value. Primitive values are stored using the size of their type.
+*	Enums are stored as int32.
+*/
+namespace EventTrace
+{
+const uint32_t VERSION = 1;
+
+const uint8_t RECORD_EVENT = 0;
+const uint8_t RECORD_CALL = 1;
+
+/**
+*	Argument type id used for strings.
+*/
+const uint8_t TYPEID_STRING = 0xFF;
+
+/**
+*	@return The size of a primitive value in the trace, or 0 if the type id is not a primitive type.
+*/
+size_t GetPrimitiveSize( const int iTypeId );
+}
+
+/**
+*	Maps an arithmetic type to the fixed size type that CASArgumentBlock stores it as.
+*	Do not use directly.
+*/
+template<size_t SIZE, bool SIGNED>
+struct BlockInteger;
+
+template<> struct BlockInteger<1, true> { typedef int8_t Type_t; };
+template<> struct BlockInteger<2, true> { typedef int16_t Type_t; };
+template<> struct BlockInteger<4, true> { typedef int32_t Type_t; };
+template<> struct BlockInteger<8, true> { typedef int64_t Type_t; };
+template<> struct BlockInteger<1, false> { typedef uint8_t Type_t; };
+template<> struct BlockInteger<2, false> { typedef uint16_t Type_t; };
+template<> struct BlockInteger<4, false> { typedef uint32_t Type_t; };
+template<> struct BlockInteger<8, false> { typedef uint64_t Type_t; };
+
+template<typename T, bool INTEGRAL = std::is_integral<T>::value>
+struct BlockArithmetic
+{
+	typedef typename std::conditional<sizeof( T ) == sizeof( float ), float, double>::type Type_t;
+};
+
+template<typename T>
+struct BlockArithmetic<T, true>
+{
+	typedef typename BlockInteger<sizeof( T ), std::is_signed<T>::value>::Type_t Type_t;
+};
+
+template<>
+struct BlockArithmetic<bool, true>
+{
+	typedef bool Type_t;
+};
+
+/**
+*	Adds a statically typed argument to an argument block so it can be recorded.
+*	Primitive types, enums and strings are supported. Other types cannot be recorded.
+*	@tparam T Argument type, without references or cv-qualifiers.
+*/
+template<typename T, typename ENABLE = void>
+struct RecordedArgument
+{
+	static bool Add( CASArgumentBlock&, const T& )
+	{
+		return false;
+	}
+};
+
+template<typename T>
+struct RecordedArgument<T, typename std::enable_if<std::is_arithmetic<T>::value>::type>
+{
+	static bool Add( CASArgumentBlock& block, const T& value )
+	{
+		return block.Add( static_cast<typename BlockArithmetic<T>::Type_t>( value ) );
+	}
+};
+
+template<typename T>
+struct RecordedArgument<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+	static bool Add( CASArgumentBlock& block, const T& value )
+	{
+		return block.Add( static_cast<int32_t>( value ) );
+	}
+};
+
+template<>
+struct RecordedArgument<std::string>
+{
+	static bool Add( CASArgumentBlock& block, const std::string& szValue )
+	{
+		return block.Add( szValue );
+	}
+};
+
+/**
+*	Helper that adds each element of a tuple to an argument block.
+*	Do not use directly.
+*	@tparam INDEX Number of elements to process.
+*/
+template<size_t INDEX, typename... ARGS>
+struct RecordedArgumentsHelper final
+{
+	typedef typename std::decay<typename std::tuple_element<INDEX - 1, std::tuple<ARGS...>>::type>::type Type_t;
+
+	static bool Add( CASArgumentBlock& block, const std::tuple<ARGS...>& args )
+	{
+		return RecordedArgumentsHelper<INDEX - 1, ARGS...>::Add( block, args ) &&
+			RecordedArgument<Type_t>::Add( block, std::get<INDEX - 1>( args ) );
+	}
+};
+
+template<typename... ARGS>
+struct RecordedArgumentsHelper<0, ARGS...> final
+{
+	static bool Add( CASArgumentBlock&, const std::tuple<ARGS...>& )
+	{
+		return true;
+	}
+};
+}
+
+/**
+*	Records event calls to a compact binary trace, so they can be replayed later using CASEventReplayer.
+*	Only primitive, enum and string arguments can be recorded. Calls with other arguments are counted, but not recorded.
+*	@see as::EventTrace
+*	@see CASEventManager::StartRecording
+*/
+class CASEventRecorder final
+{
+public:
+	/**
+	*	Constructor.
+	*	@param szFilename Name of the trace file to write.
+	*/
+	CASEventRecorder( const std::string& szFilename );
+
+	/**
+	*	Destructor. Flushes all buffered calls.
+	*/
+	~CASEventRecorder();
+
+	/**
+	*	@return Whether the trace file was opened.
+	*/
+	bool IsOpen() const { return m_File.is_open(); }
+
+	/**
+	*	@return Number of calls that were recorded.
+	*/
+	uint64_t GetRecordedCount() const { return m_uiRecordedCount; }
+
+	/**
+	*	@return Number of calls that could not be recorded because of their arguments.
+	*/
+	uint64_t GetUnrecordableCount() const { return m_uiUnrecordableCount; }
+
+	/**
+	*	Records a call.
+	*	@param event Event that was called.
+	*	@param args Arguments.
+	*/
+	void Record( const CASEvent& event, const CASArgumentBlock& args );
+
+	/**
+	*	@copydoc Record( const CASEvent&, const CASArgumentBlock& )
+	*/
+	void Record( const CASEvent& event, const CASArguments& args );
+
+	/**
+	*	Records a call with variable arguments. The event's funcdef is used to get the argument types.
+	*	@param event Event that was called.
+	*	@param list Arguments. Is not modified.
+	*/
+	void Record( const CASEvent& event, va_list list );
+
+	/**
+	*	@copydoc Record( const CASEvent&, const CASArgumentBlock& )
+	*/
+	template<typename... ARGS>
+	void Record( const CASEvent& event, const CASTypedArguments<ARGS...>& args )
+	{
+		CASArgumentBlock block;
+
+		if( as::RecordedArgumentsHelper<sizeof...( ARGS ), ARGS...>::Add( block, args.GetArguments() ) )
+			Record( event, block );
+		else
+			++m_uiUnrecordableCount;
+	}
+
+	/**
+	*	Writes all buffered calls to the trace file.
+	*/
+	void Flush();
+
+private:
+	uint32_t GetEventIndex( const CASEvent& event );
+
+	void Write( const void* pData, const size_t uiSize );
+
+	template<typename T>
+	void Write( const T& value )
+	{
+		Write( &value, sizeof( value ) );
+	}
+
+	void WriteString( const std::string& szString );
+
+private:
+	std::ofstream m_File;
+
+	std::vector<uint8_t> m_Buffer;
+
+	CASEventStats::Clock_t::time_point m_Start;
+
+	std::unordered_map<const CASEvent*, uint32_t> m_EventIndices;
+
+	uint64_t m_uiRecordedCount = 0;
+	uint64_t m_uiUnrecordableCount = 0;
+
+private:
+	CASEventRecorder( const CASEventRecorder& ) = delete;
+	CASEventRecorder& operator=( const CASEventRecorder& ) = delete;
+};
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASEVENTRECORDER_H
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+#include "AngelscriptUtils/util/ASLogging.h"
+
+#include "CASEvent.h"
+#include "CASEventCaller.h"
+#include "CASEventManager.h"
+#include "CASEventRecorder.h"
+#include "CASEventStats.h"
+
+#include "CASEventReplayer.h"
+
+namespace
+{
+/**
+*	Reads values from a trace that was loaded into memory. All reads are bounds checked.
+*/
+class CTraceReader final
+{
+public:
+	CTraceReader( const std::vector<char>& data )
+		: m_Data( data )
+	{
+	}
+
+	bool IsAtEnd() const { return m_uiOffset >= m_Data.size(); }
+
+	bool Read( void* pDest, const size_t uiSize )
+	{
+		if( m_Data.size() - m_uiOffset < uiSize )
+			return false;
+
+		memcpy( pDest, m_Data.data() + m_uiOffset, uiSize );
+
+		m_uiOffset += uiSize;
+
+		return true;
+	}
+
+	template<typename T>
+	bool Read( T& value )
+	{
+		return Read( &value, sizeof( value ) );
+	}
+
+	bool ReadString( std::string& szString )
+	{
+		uint32_t uiLength;
+
+		if( !Read( uiLength ) || m_Data.size() - m_uiOffset < uiLength )
+			return false;
+
+		szString.assign( m_Data.data() + m_uiOffset, uiLength );
+
+		m_uiOffset += uiLength;
+
+		return true;
+	}
+
+private:
+	const std::vector<char>& m_Data;
+
+	size_t m_uiOffset = 0;
+};
+
+/**
+*	Gets a percentile from a sorted list of latencies, using the nearest rank method.
+*/
+uint64_t GetPercentile( const std::vector<uint64_t>& latencies, const double flPercentile )
+{
+	if( latencies.empty() )
+		return 0;
+
+	auto uiRank = static_cast<size_t>( flPercentile / 100.0 * latencies.size() + 0.5 );
+
+	if( uiRank > 0 )
+		--uiRank;
+
+	return latencies[ std::min( uiRank, latencies.size() - 1 ) ];
+}
+}
+
+CASEventReplayer::CASEventReplayer( CASEventManager& eventManager )
+	: m_EventManager( eventManager )
+{
+}
+
+bool CASEventReplayer::Load( const std::string& szFilename )
+{
+	m_Events.clear();
+	m_Calls.clear();
+	m_uiSkippedCount = 0;
+
+	std::ifstream file( szFilename, std::ios::binary );
+
+	if( !file.is_open() )
+	{
+		as::log->error( "CASEventReplayer::Load: Couldn't open trace file \"{}\"", szFilename );
+		return false;
+	}
+
+	const std::vector<char> data( ( std::istreambuf_iterator<char>( file ) ), std::istreambuf_iterator<char>() );
+
+	CTraceReader reader( data );
+
+	char szMagic[ 4 ];
+	uint32_t uiVersion;
+
+	if( !reader.Read( szMagic, sizeof( szMagic ) ) || memcmp( szMagic, "ASET", sizeof( szMagic ) ) != 0 ||
+		!reader.Read( uiVersion ) || uiVersion != as::EventTrace::VERSION )
+	{
+		as::log->error( "CASEventReplayer::Load: \"{}\" is not a valid event trace", szFilename );
+		return false;
+	}
+
+	std::string szName;
+	std::string szArguments;
+
+	while( !reader.IsAtEnd() )
+	{
+		uint8_t uiRecordType;
+		uint32_t uiIndex;
+
+		if( !reader.Read( uiRecordType ) || !reader.Read( uiIndex ) )
+			break;
+
+		if( uiRecordType == as::EventTrace::RECORD_EVENT )
+		{
+			if( !reader.ReadString( szName ) || !reader.ReadString( szArguments ) )
+				break;
+
+			AddEvent( uiIndex, std::move( szName ), szArguments );
+
+			continue;
+		}
+
+		if( uiRecordType != as::EventTrace::RECORD_CALL || uiIndex >= m_Events.size() )
+			break;
+
+		Call call;
+
+		uint8_t uiArgCount;
+
+		if( !reader.Read( call.uiTime ) || !reader.Read( uiArgCount ) )
+			break;
+
+		call.uiEvent = uiIndex;
+
+		bool bSuccess = true;
+
+		for( uint8_t uiArg = 0; uiArg < uiArgCount && bSuccess; ++uiArg )
+		{
+			uint8_t uiTypeId;
+
+			if( !( bSuccess = reader.Read( uiTypeId ) ) )
+				break;
+
+			if( uiTypeId == as::EventTrace::TYPEID_STRING )
+			{
+				bSuccess = reader.ReadString( szArguments ) && call.arguments.Add( szArguments );
+			}
+			else
+			{
+				const auto uiSize = as::EventTrace::GetPrimitiveSize( uiTypeId );
+
+				ArgumentValue value;
+
+				bSuccess = uiSize > 0 && reader.Read( &value, uiSize ) && call.arguments.AddPrimitive( uiTypeId, value );
+			}
+		}
+
+		if( !bSuccess )
+			break;
+
+		if( m_Events[ uiIndex ].pEvent )
+			m_Calls.emplace_back( std::move( call ) );
+		else
+			++m_uiSkippedCount;
+	}
+
+	if( !reader.IsAtEnd() )
+	{
+		as::log->error( "CASEventReplayer::Load: Trace \"{}\" is corrupt", szFilename );
+		m_Calls.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void CASEventReplayer::Replay( asIScriptEngine& engine, const EventReplayMode mode )
+{
+	for( auto& event : m_Events )
+	{
+		event.latencies.clear();
+	}
+
+	if( m_Calls.empty() )
+		return;
+
+	auto pContext = engine.RequestContext();
+
+	CASEventCaller caller;
+
+	const auto start = CASEventStats::Clock_t::now();
+	const auto uiFirstTime = m_Calls.front().uiTime;
+
+	for( const auto& call : m_Calls )
+	{
+		if( mode == EventReplayMode::REALTIME )
+			std::this_thread::sleep_until( start + std::chrono::nanoseconds( call.uiTime - uiFirstTime ) );
+
+		auto& event = m_Events[ call.uiEvent ];
+
+		const auto callStart = CASEventStats::Clock_t::now();
+
+		caller.CallArgs( *event.pEvent, pContext, CallFlag::NONE, call.arguments );
+
+		event.latencies.push_back( CASEventStats::GetElapsedTime( callStart ) );
+	}
+
+	engine.ReturnContext( pContext );
+}
+
+std::string CASEventReplayer::GetReport() const
+{
+	std::ostringstream stream;
+
+	auto toUs = []( const uint64_t uiTime )
+	{
+		return uiTime / 1000.0;
+	};
+
+	for( const auto& event : m_Events )
+	{
+		if( event.latencies.empty() )
+			continue;
+
+		auto latencies = event.latencies;
+
+		std::sort( latencies.begin(), latencies.end() );
+
+		stream << "Event \"" << event.szName << "\": calls " << latencies.size()
+			<< ", p50 " << toUs( GetPercentile( latencies, 50 ) ) << " us"
+			<< ", p90 " << toUs( GetPercentile( latencies, 90 ) ) << " us"
+			<< ", p99 " << toUs( GetPercentile( latencies, 99 ) ) << " us"
+			<< ", max " << toUs( latencies.back() ) << " us\n";
+	}
+
+	return stream.str();
+}
+
+void CASEventReplayer::AddEvent( const uint32_t uiIndex, std::string&& szName, const std::string& szArguments )
+{
+	if( uiIndex >= m_Events.size() )
+		m_Events.resize( uiIndex + 1 );
+
+	auto& event = m_Events[ uiIndex ];
+
+	event.szName = std::move( szName );
+	event.pEvent = m_EventManager.FindEventByName( event.szName );
+
+	if( !event.pEvent )
+	{
+		as::log->error( "CASEventReplayer: Event \"{}\" does not exist, skipping its calls", event.szName );
+	}
+	else if( szArguments != event.pEvent->GetArguments() )
+	{
+		as::log->error( "CASEventReplayer: Event \"{}\" arguments changed from \"{}\" to \"{}\", skipping its calls",
+						event.szName, szArguments, event.pEvent->GetArguments() );
+
+		event.pEvent = nullptr;
+	}
+}
@@ -0,0 +1,125 @@
+#ifndef ANGELSCRIPT_CASEVENTREPLAYER_H
+#define ANGELSCRIPT_CASEVENTREPLAYER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <angelscript.h>
+
+#include "AngelscriptUtils/wrapper/CASArgumentBlock.h"
+
+class CASEvent;
+class CASEventManager;
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+/**
+*	How recorded calls are timed during a replay.
+*/
+enum class EventReplayMode
+{
+	/**
+	*	Call events as fast as possible.
+	*/
+	FAST,
+
+	/**
+	*	Call events at the times they were recorded at.
+	*/
+	REALTIME
+};
+
+/**
+*	Replays a trace written by CASEventRecorder through CASEventCaller, and measures how long each call takes.
+*	Events are looked up by name in the given event manager, so the trace can be replayed against a different build of the same scripts.
+*/
+class CASEventReplayer final
+{
+public:
+	/**
+	*	Constructor.
+	*	@param eventManager Event manager whose events are called.
+	*/
+	CASEventReplayer( CASEventManager& eventManager );
+	~CASEventReplayer() = default;
+
+	/**
+	*	Loads a trace. Calls to events that don't exist, or whose arguments have changed, are skipped.
+	*	@param szFilename Name of the trace file.
+	*	@return true on success, false if the file could not be read or is not a valid trace.
+	*/
+	bool Load( const std::string& szFilename );
+
+	/**
+	*	@return Number of calls that will be replayed.
+	*/
+	size_t GetCallCount() const { return m_Calls.size(); }
+
+	/**
+	*	@return Number of calls in the trace that were skipped because their event could not be found.
+	*/
+	size_t GetSkippedCount() const { return m_uiSkippedCount; }
+
+	/**
+	*	Replays all loaded calls. Latencies from previous replays are discarded.
+	*	@param engine Script engine to acquire a context from.
+	*	@param mode Replay mode.
+	*/
+	void Replay( asIScriptEngine& engine, const EventReplayMode mode = EventReplayMode::FAST );
+
+	/**
+	*	Creates a report of the last replay, with the number of calls and the latency percentiles of each event.
+	*	@return The report.
+	*/
+	std::string GetReport() const;
+
+private:
+	struct Event final
+	{
+		std::string szName;
+
+		//Null if the event could not be found.
+		CASEvent* pEvent = nullptr;
+
+		//Latency of each call, in nanoseconds.
+		std::vector<uint64_t> latencies;
+	};
+
+	struct Call final
+	{
+		size_t uiEvent;
+
+		//Time since recording started, in nanoseconds.
+		uint64_t uiTime;
+
+		CASArgumentBlock arguments;
+	};
+
+	/**
+	*	Resolves an event from the trace.
+	*/
+	void AddEvent( const uint32_t uiIndex, std::string&& szName, const std::string& szArguments );
+
+private:
+	CASEventManager& m_EventManager;
+
+	std::vector<Event> m_Events;
+
+	std::vector<Call> m_Calls;
+
+	size_t m_uiSkippedCount = 0;
+
+private:
+	CASEventReplayer( const CASEventReplayer& ) = delete;
+	CASEventReplayer& operator=( const CASEventReplayer& ) = delete;
+};
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASEVENTREPLAYER_H
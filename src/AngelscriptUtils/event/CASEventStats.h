@@ -0,0 +1,96 @@
+#ifndef ANGELSCRIPT_CASEVENTSTATS_H
+#define ANGELSCRIPT_CASEVENTSTATS_H
+
+#include <chrono>
+#include <cstdint>
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+/**
+*	Call statistics for an event or a hooked function.
+*	Only recorded while statistics are enabled for the event.
+*/
+struct CASEventStats final
+{
+	typedef std::chrono::steady_clock Clock_t;
+
+	/**
+	*	Number of times the event or function was called.
+	*/
+	uint64_t uiCallCount = 0;
+
+	/**
+	*	Number of calls that returned HANDLED.
+	*/
+	uint64_t uiHandledCount = 0;
+
+	/**
+	*	Total execution time, in nanoseconds.
+	*/
+	uint64_t uiTotalTime = 0;
+
+	/**
+	*	Longest single call, in nanoseconds.
+	*/
+	uint64_t uiMaxTime = 0;
+
+	/**
+	*	Records a call.
+	*	@param uiTime Execution time, in nanoseconds.
+	*	@param bHandled Whether the call returned HANDLED.
+	*/
+	void Add( const uint64_t uiTime, const bool bHandled )
+	{
+		++uiCallCount;
+
+		if( bHandled )
+			++uiHandledCount;
+
+		uiTotalTime += uiTime;
+
+		if( uiTime > uiMaxTime )
+			uiMaxTime = uiTime;
+	}
+
+	/**
+	*	@return Fraction of calls that returned HANDLED, in the range [0, 1].
+	*/
+	double GetHandledRate() const
+	{
+		return uiCallCount > 0 ? static_cast<double>( uiHandledCount ) / uiCallCount : 0;
+	}
+
+	/**
+	*	@return Total execution time, in milliseconds.
+	*/
+	double GetTotalTimeMs() const { return uiTotalTime / 1000000.0; }
+
+	/**
+	*	@return Longest single call, in milliseconds.
+	*/
+	double GetMaxTimeMs() const { return uiMaxTime / 1000000.0; }
+
+	/**
+	*	Clears all statistics.
+	*/
+	void Reset()
+	{
+		*this = CASEventStats();
+	}
+
+	/**
+	*	@return Time elapsed since start, in nanoseconds.
+	*/
+	static uint64_t GetElapsedTime( const Clock_t::time_point& start )
+	{
+		return static_cast<uint64_t>( std::chrono::duration_cast<std::chrono::nanoseconds>( Clock_t::now() - start ).count() );
+	}
+};
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASEVENTSTATS_H
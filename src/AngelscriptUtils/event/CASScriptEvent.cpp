@@ -0,0 +1,83 @@
+#include <cassert>
+#include <utility>
+
+#include "AngelscriptUtils/util/ASUtil.h"
+
+#include "AngelscriptUtils/wrapper/CASArguments.h"
+
+#include "CASEventCaller.h"
+
+#include "CASScriptEvent.h"
+
+CASScriptEvent::CASScriptEvent( std::string szName, asIScriptFunction& funcDef, const asDWORD accessMask )
+	: m_szName( std::move( szName ) )
+	, m_szArguments( GetArgumentsDeclaration( funcDef ) )
+	, m_pFuncDef( &funcDef )
+	, m_Event( m_szName.c_str(), m_szArguments.c_str(), "", accessMask, EventStopMode::CALL_ALL )
+{
+	m_pFuncDef->AddRef();
+
+	m_Event.SetFuncDef( m_pFuncDef );
+}
+
+CASScriptEvent::~CASScriptEvent()
+{
+	m_pFuncDef->Release();
+}
+
+bool CASScriptEvent::IsCompatibleWith( const asIScriptFunction& funcDef ) const
+{
+	return funcDef.GetReturnTypeId() == m_pFuncDef->GetReturnTypeId() &&
+		GetArgumentsDeclaration( funcDef ) == m_szArguments;
+}
+
+std::string CASScriptEvent::GetArgumentsDeclaration( const asIScriptFunction& funcDef )
+{
+	const std::string szDeclaration = funcDef.GetDeclaration( false, false, false );
+
+	const auto start = szDeclaration.find( '(' );
+	const auto end = szDeclaration.rfind( ')' );
+
+	if( start == std::string::npos || end == std::string::npos || end < start )
+		return "";
+
+	return szDeclaration.substr( start + 1, end - start - 1 );
+}
+
+/**
+*	Calls a script event with the arguments passed by the script.
+*	Returns true if any hook handled the event.
+*/
+static void CASScriptEvent_Call( asIScriptGeneric* pArguments )
+{
+	auto& event = *reinterpret_cast<CASEvent*>( pArguments->GetObject() );
+
+	bool bHandled = false;
+
+	if( event.IsHooked() || event.GetRecorder() )
+	{
+		//The script's arguments outlive the call, so value types don't need to be copied.
+		CASArguments args( *pArguments, 0, true );
+
+		bHandled = CASEventCaller().CallArgs( event, pArguments->GetEngine(), CallFlag::NONE, args ) == HookCallResult::HANDLED;
+	}
+
+	pArguments->SetReturnByte( bHandled ? 1 : 0 );
+}
+
+void RegisterScriptCScriptEvent( asIScriptEngine& engine )
+{
+	const char* const pszObjectName = "CScriptEvent";
+
+	engine.RegisterObjectType(
+		pszObjectName, 0, asOBJ_REF | asOBJ_NOCOUNT );
+
+	//No casts: only handles returned by CEventManager::CreateEvent may be called.
+	RegisterScriptCBaseEventMethods<CASEvent>( engine, pszObjectName );
+
+	as::RegisterVarArgsMethod(
+		engine, pszObjectName,
+		"bool", "Call", "",
+		0, 8,
+		asFUNCTION( CASScriptEvent_Call ) );
+}
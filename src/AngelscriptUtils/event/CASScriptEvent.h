@@ -0,0 +1,81 @@
+#ifndef ANGELSCRIPT_CASSCRIPTEVENT_H
+#define ANGELSCRIPT_CASSCRIPTEVENT_H
+
+#include <string>
+
+#include <angelscript.h>
+
+#include "CASEvent.h"
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+/**
+*	An event that was declared by a script. The event's signature is taken from a funcdef.
+*	Script events are owned by the event manager, and remain valid until the manager is destroyed, so modules can keep handles to them.
+*	Scripts trigger the event through the CScriptEvent handle returned by CEventManager::CreateEvent, without looking it up by name for every call.
+*	@see CASEventManager::CreateScriptEvent
+*/
+class CASScriptEvent final
+{
+public:
+	/**
+	*	Constructor.
+	*	@param szName Name of this event.
+	*	@param funcDef Funcdef that describes the hook signature. Is AddRef'd.
+	*	@param accessMask Access mask. Which module types this event is available to.
+	*/
+	CASScriptEvent( std::string szName, asIScriptFunction& funcDef, const asDWORD accessMask );
+	~CASScriptEvent();
+
+	/**
+	*	@return The event name.
+	*/
+	const std::string& GetName() const { return m_szName; }
+
+	/**
+	*	@return The event.
+	*/
+	CASEvent& GetEvent() { return m_Event; }
+
+	/**
+	*	@copydoc GetEvent()
+	*/
+	const CASEvent& GetEvent() const { return m_Event; }
+
+	/**
+	*	@return Whether the given funcdef has the same signature as the one this event was created with.
+	*/
+	bool IsCompatibleWith( const asIScriptFunction& funcDef ) const;
+
+	/**
+	*	Gets the argument declaration for a funcdef, e.g. "int, const string&in".
+	*/
+	static std::string GetArgumentsDeclaration( const asIScriptFunction& funcDef );
+
+private:
+	//Must be initialized before the event, which references them.
+	const std::string m_szName;
+	const std::string m_szArguments;
+
+	asIScriptFunction* const m_pFuncDef;
+
+	CASEvent m_Event;
+
+private:
+	CASScriptEvent( const CASScriptEvent& ) = delete;
+	CASScriptEvent& operator=( const CASScriptEvent& ) = delete;
+};
+
+/**
+*	Registers the CScriptEvent class. CBaseEvent must be registered first.
+*	@param engine Script engine.
+*/
+void RegisterScriptCScriptEvent( asIScriptEngine& engine );
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASSCRIPTEVENT_H
@@ -0,0 +1,215 @@
+#ifndef ANGELSCRIPT_CASTYPEDEVENT_H
+#define ANGELSCRIPT_CASTYPEDEVENT_H
+
+#include <string>
+#include <utility>
+
+#include <angelscript.h>
+
+#include "AngelscriptUtils/util/ASLogging.h"
+
+#include "AngelscriptUtils/wrapper/CASTypedArguments.h"
+
+#include "CASEvent.h"
+#include "CASEventCaller.h"
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+/**
+*	An event whose arguments are statically typed.
+*	The script argument declaration is derived from the C++ argument types, and is checked against the registered funcdef once.
+*	Calls set the arguments directly on the context, without decoding varargs for every hooked function.
+*	Add the event returned by GetEvent to the event manager to register it.
+*	@tparam ARGS C++ argument types. Each type must have an as::ArgumentTraits specialization.
+*/
+template<typename... ARGS>
+class CASTypedEvent final
+{
+public:
+	typedef CASTypedArguments<ARGS...> Arguments_t;
+
+public:
+	/**
+	*	Constructor.
+	*	@param pszName Name of this event.
+	*	@param pszCategory Which category this hook is in. This is a double colon delimited list, e.g. "Game::Player".
+	*	@param accessMask Access mask. Which module types this hook is available to.
+	*	@param stopMode Stop mode.
+	*	@see EventStopMode
+	*/
+	CASTypedEvent( const char* const pszName, const char* const pszCategory, const asDWORD accessMask, const EventStopMode stopMode )
+		: m_szArguments( Arguments_t::GetDeclaration() )
+		, m_Event( pszName, m_szArguments.c_str(), pszCategory, accessMask, stopMode )
+	{
+	}
+
+	/**
+	*	@return The event.
+	*/
+	CASEvent& GetEvent() { return m_Event; }
+
+	/**
+	*	@copydoc GetEvent()
+	*/
+	const CASEvent& GetEvent() const { return m_Event; }
+
+	/**
+	*	@copydoc CASBaseEvent::IsHooked() const
+	*/
+	bool IsHooked() const { return m_Event.IsHooked(); }
+
+	/**
+	*	Checks whether the registered funcdef matches the C++ argument types. The result is cached until the funcdef changes.
+	*	@return true if the event can be called, false otherwise.
+	*/
+	bool Validate()
+	{
+		auto pFuncDef = m_Event.GetFuncDef();
+
+		if( !pFuncDef )
+		{
+			as::log->critical( "CASTypedEvent::Validate: Event \"{}\" has not been registered!", m_Event.GetName() );
+			return false;
+		}
+
+		if( pFuncDef != m_pValidatedFuncDef )
+		{
+			m_pValidatedFuncDef = pFuncDef;
+
+			m_bValid = Arguments_t::IsCompatibleWith( *pFuncDef );
+
+			if( !m_bValid )
+			{
+				as::log->critical( "CASTypedEvent::Validate: Event \"{}\" arguments \"{}\" do not match funcdef \"{}\"!",
+								   m_Event.GetName(), m_szArguments, pFuncDef->GetDeclaration() );
+			}
+		}
+
+		return m_bValid;
+	}
+
+	/**
+	*	Calls the event using the given context.
+	*	@param pContext Context to use.
+	*	@param args Arguments.
+	*/
+	HookCallResult Call( asIScriptContext* pContext, ARGS... args )
+	{
+		return CallWith( CASEventCaller(), pContext, std::forward<ARGS>( args )... );
+	}
+
+	/**
+	*	Calls the event using a context acquired from the given engine.
+	*	@param pScriptEngine Script engine to use.
+	*	@param args Arguments.
+	*/
+	HookCallResult Call( asIScriptEngine* pScriptEngine, ARGS... args )
+	{
+		return CallWith( CASEventCaller(), pScriptEngine, std::forward<ARGS>( args )... );
+	}
+
+	/**
+	*	Calls the hooks for the given key, and hooks without a key, using the given context.
+	*	@param iKey Key.
+	*	@param pContext Context to use.
+	*	@param args Arguments.
+	*/
+	HookCallResult CallKeyed( const int iKey, asIScriptContext* pContext, ARGS... args )
+	{
+		return CallWith( CASEventCaller( iKey ), pContext, std::forward<ARGS>( args )... );
+	}
+
+	/**
+	*	Calls the hooks for the given key, and hooks without a key, using a context acquired from the given engine.
+	*	@param iKey Key.
+	*	@param pScriptEngine Script engine to use.
+	*	@param args Arguments.
+	*/
+	HookCallResult CallKeyed( const int iKey, asIScriptEngine* pScriptEngine, ARGS... args )
+	{
+		return CallWith( CASEventCaller( iKey ), pScriptEngine, std::forward<ARGS>( args )... );
+	}
+
+	/**
+	*	Calls only the hooks that belong to the given module, using the given context.
+	*	@param module Module.
+	*	@param pContext Context to use.
+	*	@param args Arguments.
+	*/
+	HookCallResult CallModule( const CASModule& module, asIScriptContext* pContext, ARGS... args )
+	{
+		return CallWith( CASEventCaller( module ), pContext, std::forward<ARGS>( args )... );
+	}
+
+	/**
+	*	Calls only the hooks that belong to the given module, using a context acquired from the given engine.
+	*	@param module Module.
+	*	@param pScriptEngine Script engine to use.
+	*	@param args Arguments.
+	*/
+	HookCallResult CallModule( const CASModule& module, asIScriptEngine* pScriptEngine, ARGS... args )
+	{
+		return CallWith( CASEventCaller( module ), pScriptEngine, std::forward<ARGS>( args )... );
+	}
+
+	/**
+	*	Calls only the hooks that belong to modules that use the given descriptor, using the given context.
+	*	@param descriptor Descriptor.
+	*	@param pContext Context to use.
+	*	@param args Arguments.
+	*/
+	HookCallResult CallDescriptor( const CASModuleDescriptor& descriptor, asIScriptContext* pContext, ARGS... args )
+	{
+		return CallWith( CASEventCaller( descriptor ), pContext, std::forward<ARGS>( args )... );
+	}
+
+	/**
+	*	Calls only the hooks that belong to modules that use the given descriptor, using a context acquired from the given engine.
+	*	@param descriptor Descriptor.
+	*	@param pScriptEngine Script engine to use.
+	*	@param args Arguments.
+	*/
+	HookCallResult CallDescriptor( const CASModuleDescriptor& descriptor, asIScriptEngine* pScriptEngine, ARGS... args )
+	{
+		return CallWith( CASEventCaller( descriptor ), pScriptEngine, std::forward<ARGS>( args )... );
+	}
+
+private:
+	/**
+	*	Calls the event with the given caller, if anything is listening to it and its funcdef matches the C++ argument types.
+	*	@param caller Caller that selects the hooks to call.
+	*	@param pContext Context or script engine to use.
+	*	@param args Arguments.
+	*/
+	template<typename CONTEXT>
+	HookCallResult CallWith( CASEventCaller caller, CONTEXT* pContext, ARGS... args )
+	{
+		if( !m_Event.IsHooked() && !m_Event.GetRecorder() )
+			return HookCallResult::NONE_HANDLED;
+
+		if( !Validate() )
+			return HookCallResult::FAILED;
+
+		return caller.CallArgs( m_Event, pContext, CallFlag::NONE, Arguments_t( std::forward<ARGS>( args )... ) );
+	}
+
+	//Must be initialized before the event, which references it.
+	const std::string m_szArguments;
+
+	CASEvent m_Event;
+
+	asIScriptFunction* m_pValidatedFuncDef = nullptr;
+	bool m_bValid = false;
+
+private:
+	CASTypedEvent( const CASTypedEvent& ) = delete;
+	CASTypedEvent& operator=( const CASTypedEvent& ) = delete;
+};
+
+/** @} */
+
+#endif //ANGELSCRIPT_CASTYPEDEVENT_H
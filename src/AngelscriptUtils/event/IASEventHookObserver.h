@@ -0,0 +1,36 @@
+#ifndef ANGELSCRIPT_IASEVENTHOOKOBSERVER_H
+#define ANGELSCRIPT_IASEVENTHOOKOBSERVER_H
+
+class CASBaseEvent;
+class CASModule;
+
+/**
+*	@addtogroup ASEvents
+*
+*	@{
+*/
+
+/**
+*	Interface for classes that track which modules have hooked into events.
+*/
+class IASEventHookObserver
+{
+public:
+	virtual ~IASEventHookObserver() = 0;
+
+	/**
+	*	Called when functions belonging to the given module have been added to or removed from an event.
+	*	Use CASBaseEvent::HasFunctionsOfModule to check whether the module still has functions hooked into the event.
+	*	@param event Event whose hooks changed.
+	*	@param pModule Module whose functions were added or removed.
+	*/
+	virtual void OnModuleHooksChanged( CASBaseEvent& event, CASModule* pModule ) = 0;
+};
+
+inline IASEventHookObserver::~IASEventHookObserver()
+{
+}
+
+/** @} */
+
+#endif //ANGELSCRIPT_IASEVENTHOOKOBSERVER_H
@@ -9,6 +9,16 @@
 	#endif
 #endif
 
+/**
+*	Declares a thread-local variable. Uses the compiler specific storage class, since VS2013 does not support thread_local.
+*	Only use this with types that don't need dynamic initialization or destruction.
+*/
+#ifdef _MSC_VER
+	#define AS_THREAD_LOCAL __declspec( thread )
+#else
+	#define AS_THREAD_LOCAL __thread
+#endif
+
 /**
 *	Creates a directory
 */
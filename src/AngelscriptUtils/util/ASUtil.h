@@ -948,6 +948,32 @@ inline bool GetCallerInfo( CASCallerInfo& info, asIScriptContext* pContext = nul
 {
 	return GetCallerInfo( info.pszSection, info.iLine, info.iColumn, pContext );
 }
+
+/**
+*	Gets the function that the current call on a context started executing, i.e. the bottom of the callstack.
+*	Calls nested using asIScriptContext::PushState are separate calls: the entry function of the innermost nested call is returned.
+*	@param context Context.
+*	@return The entry function, or null if the context isn't executing a script.
+*/
+inline asIScriptFunction* GetEntryFunction( asIScriptContext& context )
+{
+	asIScriptFunction* pEntryFunction = nullptr;
+
+	const asUINT uiCallstackSize = context.GetCallstackSize();
+
+	for( asUINT uiLevel = 0; uiLevel < uiCallstackSize; ++uiLevel )
+	{
+		auto pFunction = context.GetFunction( uiLevel );
+
+		//Nested states are separated by a frame without a function.
+		if( !pFunction )
+			break;
+
+		pEntryFunction = pFunction;
+	}
+
+	return pEntryFunction;
+}
 }
 
 /** @} */
@@ -6,6 +6,7 @@
 
 #include "AngelscriptUtils/wrapper/CASContext.h"
 #include "AngelscriptUtils/wrapper/ASCallable.h"
+#include "AngelscriptUtils/wrapper/CASArgumentBlock.h"
 
 #include "ContextUtils.h"
 
@@ -65,7 +66,12 @@ bool SetArguments( const asIScriptFunction& targetFunc, asIScriptContext& contex
 	return bSuccess;
 }
 
-bool SetArgument( asIScriptEngine& engine, void* pData, int iTypeId, CASArgument& arg )
+bool SetArguments( const asIScriptFunction& targetFunc, asIScriptContext& context, const CASArgumentBlock& arguments )
+{
+	return arguments.SetArguments( targetFunc, context );
+}
+
+bool SetArgument( asIScriptEngine& engine, void* pData, int iTypeId, CASArgument& arg, const bool bBorrowValues )
 {
 	bool bSuccess = true;
 
@@ -74,7 +80,7 @@ bool SetArgument( asIScriptEngine& engine, void* pData, int iTypeId, CASArgument
 	bSuccess = SetPrimitiveArgument( pData, iTypeId, arg, bWasPrimitive );
 
 	if( bSuccess && !bWasPrimitive )
-		bSuccess = SetObjectArgument( engine, pData, iTypeId, arg );
+		bSuccess = SetObjectArgument( engine, pData, iTypeId, arg, bBorrowValues );
 
 	return bSuccess;
 }
@@ -325,11 +331,11 @@ bool GetArgumentFromVarargs( ArgumentValue& value, int iTypeId, asDWORD uiTMFlag
 
 			case asTYPEID_BOOL:
 			case asTYPEID_INT8:
-			case asTYPEID_UINT8:	value.byte = static_cast<asBYTE>( va_arg( list.list, long ) ); break; //Promoted to int
+			case asTYPEID_UINT8:	value.byte = static_cast<asBYTE>( va_arg( list.list, int ) ); break; //Promoted to int
 			case asTYPEID_INT16:
-			case asTYPEID_UINT16:	value.word = static_cast<asWORD>( va_arg( list.list, long ) ); break; //Promoted to int
-			case asTYPEID_INT32:
-			case asTYPEID_UINT32:	value.dword = static_cast<asDWORD>( va_arg( list.list, long ) ); break;
+			case asTYPEID_UINT16:	value.word = static_cast<asWORD>( va_arg( list.list, int ) ); break; //Promoted to int
+			case asTYPEID_INT32:	value.dword = static_cast<asDWORD>( va_arg( list.list, int ) ); break;
+			case asTYPEID_UINT32:	value.dword = static_cast<asDWORD>( va_arg( list.list, unsigned int ) ); break;
 			case asTYPEID_INT64:
 			case asTYPEID_UINT64:	value.qword = va_arg( list.list, long long ); break;
 
@@ -346,7 +352,7 @@ bool GetArgumentFromVarargs( ArgumentValue& value, int iTypeId, asDWORD uiTMFlag
 					if( pOutArgType )
 						*pOutArgType = ArgType::ENUM;
 
-					value.dword = va_arg( list.list, long );
+					value.dword = static_cast<asDWORD>( va_arg( list.list, int ) );
 				}
 				else
 				{
@@ -623,7 +629,7 @@ bool SetPrimitiveArgument( void* pData, int iTypeId, ArgumentValue& value, bool&
 	return bSuccess;
 }
 
-bool SetObjectArgument( asIScriptEngine& engine, void* pObject, int iTypeId, CASArgument& arg )
+bool SetObjectArgument( asIScriptEngine& engine, void* pObject, int iTypeId, CASArgument& arg, const bool bBorrowValues )
 {
 	bool bSuccess = true;
 
@@ -638,7 +644,7 @@ bool SetObjectArgument( asIScriptEngine& engine, void* pObject, int iTypeId, CAS
 		if( uiFlags & asOBJ_VALUE )
 		{
 			argType = ArgType::VALUE;
-			value.pValue = engine.CreateScriptObjectCopy( pObject, pType );
+			value.pValue = bBorrowValues ? pObject : engine.CreateScriptObjectCopy( pObject, pType );
 		}
 		else if( uiFlags & asOBJ_REF ) //is it a reference type?
 		{
@@ -696,7 +702,12 @@ bool SetObjectArgument( asIScriptEngine& engine, void* pObject, int iTypeId, CAS
 	}
 
 	if( bSuccess )
-		arg.Set( iTypeId, argType, value );
+	{
+		if( bBorrowValues && argType == ArgType::VALUE )
+			arg.Borrow( engine, iTypeId, argType, value );
+		else
+			arg.Set( engine, iTypeId, argType, value );
+	}
 
 	return bSuccess;
 }
@@ -4,6 +4,9 @@
 #include <angelscript.h>
 
 #include "AngelscriptUtils/wrapper/CASArguments.h"
+#include "AngelscriptUtils/wrapper/CASTypedArguments.h"
+
+class CASArgumentBlock;
 
 /**
 *	@addtogroup ASContext
@@ -39,15 +42,25 @@ bool SetArguments( const asIScriptFunction& targetFunc, asIScriptContext& contex
 */
 bool SetArguments( const asIScriptFunction& targetFunc, asIScriptContext& context, va_list list );
 
+/**
+*	Sets arguments for a function call.
+*	@param targetFunc Target function.
+*	@param context Context.
+*	@param arguments Block of arguments.
+*	@return true on success, false otherwise.
+*/
+bool SetArguments( const asIScriptFunction& targetFunc, asIScriptContext& context, const CASArgumentBlock& arguments );
+
 /**
 *	Sets an argument on arg. Determines whether it's a primitive or object argument.
 *	@param engine Script engine.
 *	@param pData Data to copy.
 *	@param iTypeId Type Id.
 *	@param arg Argument to set.
+*	@param bBorrowValues Whether value types should be borrowed instead of copied.
 *	@return true on success, false otherwise.
 */
-bool SetArgument( asIScriptEngine& engine, void* pData, int iTypeId, CASArgument& arg );
+bool SetArgument( asIScriptEngine& engine, void* pData, int iTypeId, CASArgument& arg, const bool bBorrowValues = false );
 
 /**
 *	Sets an argument on the context, taking the argument from a CASArgument.
@@ -163,9 +176,10 @@ bool SetPrimitiveArgument( void* pData, int iTypeId, ArgumentValue& value, bool&
 *	@param pObject Object to copy or addref.
 *	@param iTypeId Type Id.
 *	@param arg Argument to set.
+*	@param bBorrowValues Whether value types should be borrowed instead of copied. The object must outlive the argument.
 *	@return true on success, false otherwise.
 */
-bool SetObjectArgument( asIScriptEngine& engine, void* pObject, int iTypeId, CASArgument& arg );
+bool SetObjectArgument( asIScriptEngine& engine, void* pObject, int iTypeId, CASArgument& arg, const bool bBorrowValues = false );
 
 /**
 *	Convenience method for when you don't want to get return type info yourself.
@@ -3,16 +3,21 @@
 
 #include <cassert>
 #include <cstdarg>
+#include <string>
 
 #include <angelscript.h>
 
+#include "AngelscriptUtils/util/ASLogging.h"
 #include "AngelscriptUtils/util/ASPlatform.h"
+#include "AngelscriptUtils/util/ASUtil.h"
 #include "AngelscriptUtils/util/ContextUtils.h"
 
 #include "AngelscriptUtils/IASContextResultHandler.h"
 
 #include "ASCallableConst.h"
+#include "ASReturnTraits.h"
 #include "CASContext.h"
+#include "CASTypedArguments.h"
 
 class CASContext;
 class CASArguments;
@@ -27,6 +32,9 @@ namespace as
 {
 /**
 *	Calls a function.
+*	If the context is executing a script, the call is nested: the context's state is pushed, and popped when the callable is destroyed or makes its next call.
+*	If the state can't be pushed, the call is made on a context acquired using asIScriptEngine::RequestContext instead.
+*	The result of executing the function is stored in the callable, see CASCallable::GetExecuteResult.
 *	@param callable Callable object.
 *	@param flags Call flags.
 *	@param args The arguments for the function.
@@ -35,7 +43,7 @@ namespace as
 *	@return true on success, false otherwise.
 */
 template<typename CALLABLE, typename ARGS>
-bool CallFunction( CALLABLE& callable, CallFlags_t, const ARGS& args )
+bool CallFunction( CALLABLE& callable, CallFlags_t flags, const ARGS& args )
 {
 	auto pContext = callable.GetContext().GetContext();
 
@@ -44,6 +52,14 @@ bool CallFunction( CALLABLE& callable, CallFlags_t, const ARGS& args )
 	if( !pContext )
 		return false;
 
+	callable.m_iExecuteResult = asEXECUTION_UNINITIALIZED;
+
+	if( !callable.BeginCall() )
+		return false;
+
+	//Nested calls may have fallen back to a different context.
+	pContext = callable.GetCallContext();
+
 	auto& function = callable.GetFunction();
 
 	auto result = pContext->Prepare( &function );
@@ -71,9 +87,14 @@ bool CallFunction( CALLABLE& callable, CallFlags_t, const ARGS& args )
 
 	result = pContext->Execute();
 
+	callable.m_iExecuteResult = result;
+
 	if( pResultHandler )
 		pResultHandler->ProcessExecuteResult( function, *pContext, result );
 
+	if( result == asEXECUTION_EXCEPTION && callable.IsNested() && ( flags & CallFlag::PROPAGATE_EXCEPTION ) )
+		callable.PropagateException();
+
 	if( !callable.PostExecute( result ) )
 		return false;
 
@@ -99,6 +120,11 @@ public:
 	*/
 	CASCallable( asIScriptFunction& function, CASContext& context );
 
+	/**
+	*	Destructor. If the call was nested, restores the context's previous state.
+	*/
+	~CASCallable();
+
 	/**
 	*	@return The function.
 	*/
@@ -114,13 +140,51 @@ public:
 	*/
 	bool IsValid() const;
 
+	/**
+	*	@return Whether the call was nested in a script call on the same context.
+	*/
+	bool IsNested() const { return m_bPushedState; }
+
+	/**
+	*	@return The context that calls are made on. This is the callable's context, unless a nested call had to fall back to a new context.
+	*/
+	asIScriptContext* GetCallContext() { return m_pFallbackContext ? m_pFallbackContext : m_Context.GetContext(); }
+
+	/**
+	*	@return The result of the last asIScriptContext::Execute call, or asEXECUTION_UNINITIALIZED if the function was never executed.
+	*	Calls that raised an exception, were aborted or were suspended still count as successful calls, so check this if the difference matters.
+	*/
+	int GetExecuteResult() const { return m_iExecuteResult; }
+
+	/**
+	*	@return Whether the last call ran to completion. Only then can the return value be read.
+	*/
+	bool HasFinished() const { return m_iExecuteResult == asEXECUTION_FINISHED; }
+
 	/**
 	*	Gets the return value.
 	*	@param pReturnValue Pointer to the variable that will receive the return value. Must match the type being retrieved.
-	*	@return true if the value was successfully retrieved, false otherwise.
+	*	@return true if the value was successfully retrieved, false otherwise, or if the last call did not finish.
 	*/
 	bool GetReturnValue( void* pReturnValue );
 
+	/**
+	*	Gets the return value as the given type. The value is read directly from the context, without looking up the return type.
+	*	The return type must have been checked beforehand, e.g. using as::ValidateReturnType, or when the function was registered.
+	*	Only valid if the last call finished, see HasFinished.
+	*	@tparam T C++ return type. Must have an as::ReturnTraits specialization.
+	*	@return The return value.
+	*/
+	template<typename T>
+	T GetReturnValue()
+	{
+		assert( m_Context );
+		assert( HasFinished() );
+		assert( as::ValidateReturnType<T>( m_Function ) );
+
+		return as::ReturnTraits<T>::Get( *GetCallContext() );
+	}
+
 protected:
 	/**
 	*	Called before the arguments are set. Lets the callable type evaluate itself.
@@ -144,10 +208,39 @@ protected:
 	*/
 	bool PostExecute( const int iResult );
 
+private:
+	/**
+	*	Sets up the context for a call. Restores the calling script's state if a previous call made with this callable was nested,
+	*	and nests the call if the context is executing a script.
+	*	@return true if the call can be made, false otherwise.
+	*/
+	bool BeginCall();
+
+	/**
+	*	Saves the state of the context so a nested call can be made. The state is restored when this callable is destroyed.
+	*	If the state can't be saved, e.g. because the context's nesting limit was reached, a new context is requested for the call instead.
+	*	@return true on success, false otherwise.
+	*/
+	bool PushState();
+
+	/**
+	*	Restores the context's previous state, and raises the nested call's exception in the calling script.
+	*/
+	void PropagateException();
+
+	void PopState();
+
 private:
 	asIScriptFunction& m_Function;
 	CASContext& m_Context;
 
+	bool m_bPushedState = false;
+
+	//Context used if the state could not be pushed. Returned to the engine when this callable is destroyed.
+	asIScriptContext* m_pFallbackContext = nullptr;
+
+	int m_iExecuteResult = asEXECUTION_UNINITIALIZED;
+
 private:
 	CASCallable( const CASCallable& ) = delete;
 	CASCallable& operator=( const CASCallable& ) = delete;
@@ -159,19 +252,102 @@ inline CASCallable::CASCallable( asIScriptFunction& function, CASContext& contex
 {
 }
 
+inline CASCallable::~CASCallable()
+{
+	PopState();
+
+	if( m_pFallbackContext )
+		m_pFallbackContext->GetEngine()->ReturnContext( m_pFallbackContext );
+}
+
 inline bool CASCallable::IsValid() const
 {
 	return m_Context.GetContext() != nullptr;
 }
 
+inline bool CASCallable::BeginCall()
+{
+	//The callable can be used for more than one call. The previous call's state is only kept so its return value can be read.
+	PopState();
+
+	//Reuse the context that a previous nested call fell back to.
+	if( m_pFallbackContext )
+		return true;
+
+	auto pContext = m_Context.GetContext();
+
+	if( pContext->GetState() == asEXECUTION_ACTIVE )
+		return PushState();
+
+	if( pContext == asGetActiveContext() )
+	{
+		//The calling script raised an exception, possibly propagated from an earlier nested call. Preparing the context would destroy the calling script's state.
+		as::log->error( "CASCallable::BeginCall: Couldn't call \"{}\": the calling script's context is not active ({})",
+						as::FormatFunctionName( m_Function ), pContext->GetState() );
+		return false;
+	}
+
+	return true;
+}
+
+inline bool CASCallable::PushState()
+{
+	assert( !m_bPushedState );
+
+	const auto result = m_Context.GetContext()->PushState();
+
+	if( result < 0 )
+	{
+		m_pFallbackContext = m_Context.GetContext()->GetEngine()->RequestContext();
+
+		if( !m_pFallbackContext )
+		{
+			as::log->error( "CASCallable::PushState: Couldn't push context state for nested call to \"{}\" ({}), and couldn't request a new context",
+							as::FormatFunctionName( m_Function ), result );
+			return false;
+		}
+
+		return true;
+	}
+
+	m_bPushedState = true;
+
+	return true;
+}
+
+inline void CASCallable::PropagateException()
+{
+	auto pContext = m_Context.GetContext();
+
+	//The exception string belongs to the nested state, so copy it before popping.
+	const std::string szException = pContext->GetExceptionString() ? pContext->GetExceptionString() : "";
+
+	PopState();
+
+	pContext->SetException( szException.c_str() );
+}
+
+inline void CASCallable::PopState()
+{
+	if( !m_bPushedState )
+		return;
+
+	m_bPushedState = false;
+
+	m_Context.GetContext()->PopState();
+}
+
 inline bool CASCallable::GetReturnValue( void* pReturnValue )
 {
 	assert( m_Context );
 
+	if( !HasFinished() )
+		return false;
+
 	asDWORD uiFlags;
 	const int iTypeId = m_Function.GetReturnTypeId( &uiFlags );
 
-	return ctx::GetReturnValue( *m_Context.GetContext(), iTypeId, uiFlags, pReturnValue );
+	return ctx::GetReturnValue( *GetCallContext(), iTypeId, uiFlags, pReturnValue );
 }
 
 inline bool CASCallable::PostExecute( const int )
@@ -233,6 +409,19 @@ public:
 		return as::CallFunction( GetThisRef(), flags, args );
 	}
 
+	/**
+	*	Calls the function with statically typed arguments. The function's parameters are not checked.
+	*	@param flags Call flags.
+	*	@param args List of arguments.
+	*	@return true on success, false otherwise.
+	*	@see CASTypedArguments::IsCompatibleWith
+	*/
+	template<typename... ARGS>
+	bool CallTyped( CallFlags_t flags, const CASTypedArguments<ARGS...>& args )
+	{
+		return as::CallFunction( GetThisRef(), flags, args );
+	}
+
 	/**
 	*	Calls the function.
 	*	@param flags Call flags.
@@ -307,7 +496,7 @@ inline bool CASMethod::IsValid() const
 
 inline bool CASMethod::PreSetArguments()
 {
-	auto pContext = GetContext().GetContext();
+	auto pContext = GetCallContext();
 
 	return pContext->SetObject( m_pThis ) >= 0;
 }
@@ -318,7 +507,8 @@ namespace as
 *	Performs a function call.
 *	Do not use directly.
 *	@param functor Functor that Can perform function calls.
-*	@param pContext Script context. If null, acquires a context using asIScriptEngine::RequestContext.
+*	@param pContext Script context. If null, the context of a script executing on this thread is borrowed for a nested call,
+*					otherwise a context is acquired using asIScriptEngine::RequestContext.
 *	@param flags Call flags.
 *	@param pFunction Function to call.
 *	@param args Argument list to use for the call.
@@ -342,7 +532,7 @@ inline bool VCall( FUNCTOR functor, asIScriptContext* pContext, CallFlags_t flag
 	}
 	else
 	{
-		CASOwningContext ctx( *pFunction->GetEngine() );
+		CASOwningContext ctx( *pFunction->GetEngine(), true );
 
 		return functor( *pFunction, ctx, flags, args );
 	}
@@ -386,6 +576,24 @@ struct CASFunctionFunctor final
 
 		return func.CallArgs( flags, args );
 	}
+
+	/**
+	*	Calls a function using statically typed arguments.
+	*	@param function Function to call.
+	*	@param context Context to use.
+	*	@param flags Call flags.
+	*	@param args List of arguments.
+	*/
+	template<typename... ARGS>
+	bool operator()( asIScriptFunction& function, CASContext& context, CallFlags_t flags, const CASTypedArguments<ARGS...>& args )
+	{
+		CASFunction func( function, context );
+
+		if( !func.IsValid() )
+			return false;
+
+		return func.CallTyped( flags, args );
+	}
 };
 
 /**
@@ -440,6 +648,24 @@ struct CASMethodFunctor final
 		return method.CallArgs( flags, args );
 	}
 
+	/**
+	*	Calls an object method using statically typed arguments.
+	*	@param function Function to call.
+	*	@param context Context to use.
+	*	@param flags Call flags.
+	*	@param args List of arguments.
+	*/
+	template<typename... ARGS>
+	bool operator()( asIScriptFunction& function, CASContext& context, CallFlags_t flags, const CASTypedArguments<ARGS...>& args )
+	{
+		CASMethod method( function, context, pThis );
+
+		if( !method.IsValid() )
+			return false;
+
+		return method.CallTyped( flags, args );
+	}
+
 private:
 	CASMethodFunctor& operator=( const CASMethodFunctor& ) = delete;
 };
@@ -573,6 +799,300 @@ va_end( list );
 */
 __IMPLEMENT_CALL_SIMPLE( Call, VCallFunc, __VA_ARG_PARAM, list, __BEGIN_VA_LIST, __END_VA_LIST )
 
+/**
+*	Prevents template argument deduction, so typed calls must list their argument types explicitly.
+*	Do not use directly.
+*/
+template<typename T>
+struct NonDeduced final
+{
+	typedef T Type_t;
+};
+
+/**
+*	Checks whether a function can be called with the given argument types.
+*	The result is cached in the function's user data, so the function's parameters are only inspected
+*	the first time it is called with a given argument list.
+*	@param function Function to check.
+*	@tparam ARGS C++ argument types.
+*	@return true if the parameters match, false otherwise.
+*/
+template<typename... ARGS>
+bool ValidateTypedCall( asIScriptFunction& function )
+{
+	//The address of this variable identifies the argument list.
+	static const char signatureTag = 0;
+
+	void* const pTag = const_cast<char*>( &signatureTag );
+
+	if( function.GetUserData( ASUTILS_CALL_SIGNATURE_USERDATA_ID ) == pTag )
+		return true;
+
+	if( !CASTypedArguments<ARGS...>::IsCompatibleWith( function ) )
+	{
+		as::log->error( "as::Call: Function \"{}\" cannot be called with arguments ({})",
+						as::FormatFunctionName( function ), CASTypedArguments<ARGS...>::GetDeclaration() );
+		return false;
+	}
+
+	function.SetUserData( pTag, ASUTILS_CALL_SIGNATURE_USERDATA_ID );
+
+	return true;
+}
+
+/**
+*	Performs a call with statically typed arguments.
+*	Do not use directly.
+*/
+template<typename... ARGS, typename... FUNCARGS>
+inline bool TypedCallFunc( asIScriptContext* pContext, CallFlags_t flags, asIScriptFunction* pFunction, FUNCARGS&&... args )
+{
+	assert( pFunction );
+
+	if( !pFunction || !ValidateTypedCall<ARGS...>( *pFunction ) )
+		return false;
+
+	const CASTypedArguments<ARGS...> arguments( std::forward<FUNCARGS>( args )... );
+
+	return VCallFunc( pContext, flags, pFunction, arguments );
+}
+
+/**
+*	@copydoc TypedCallFunc( asIScriptContext*, CallFlags_t, asIScriptFunction*, FUNCARGS&&... )
+*/
+template<typename... ARGS, typename... FUNCARGS>
+inline bool TypedCallFunc( void* pThis, asIScriptContext* pContext, CallFlags_t flags, asIScriptFunction* pFunction, FUNCARGS&&... args )
+{
+	assert( pFunction );
+
+	if( !pFunction || !ValidateTypedCall<ARGS...>( *pFunction ) )
+		return false;
+
+	const CASTypedArguments<ARGS...> arguments( std::forward<FUNCARGS>( args )... );
+
+	return VCallFunc( pThis, pContext, flags, pFunction, arguments );
+}
+
+/**
+*	Internal helper functor used for calls that read the return value.
+*	@tparam T C++ return type.
+*/
+template<typename T>
+struct CASFunctionReturnFunctor final
+{
+	T& returnValue;
+
+	/**
+	*	Constructor.
+	*	@param returnValue Variable that receives the return value.
+	*/
+	CASFunctionReturnFunctor( T& returnValue )
+		: returnValue( returnValue )
+	{
+	}
+
+	CASFunctionReturnFunctor( const CASFunctionReturnFunctor& other ) = default;
+
+	/**
+	*	Calls a function and reads its return value.
+	*	@param function Function to call.
+	*	@param context Context to use.
+	*	@param flags Call flags.
+	*	@param args List of arguments.
+	*/
+	template<typename ARGS>
+	bool operator()( asIScriptFunction& function, CASContext& context, CallFlags_t flags, const ARGS& args )
+	{
+		CASFunction func( function, context );
+
+		//Exceptions, aborts and suspends leave no return value to read.
+		if( !func.IsValid() || !CallFunction( func, flags, args ) || !func.HasFinished() )
+			return false;
+
+		returnValue = func.GetReturnValue<T>();
+
+		return true;
+	}
+
+private:
+	CASFunctionReturnFunctor& operator=( const CASFunctionReturnFunctor& ) = delete;
+};
+
+/**
+*	Internal helper functor used for method calls that read the return value.
+*	@tparam T C++ return type.
+*/
+template<typename T>
+struct CASMethodReturnFunctor final
+{
+	void* const pThis;
+	T& returnValue;
+
+	/**
+	*	Constructor.
+	*	@param pThis This pointer.
+	*	@param returnValue Variable that receives the return value.
+	*/
+	CASMethodReturnFunctor( void* pThis, T& returnValue )
+		: pThis( pThis )
+		, returnValue( returnValue )
+	{
+	}
+
+	CASMethodReturnFunctor( const CASMethodReturnFunctor& other ) = default;
+
+	/**
+	*	Calls an object method and reads its return value.
+	*	@param function Function to call.
+	*	@param context Context to use.
+	*	@param flags Call flags.
+	*	@param args List of arguments.
+	*/
+	template<typename ARGS>
+	bool operator()( asIScriptFunction& function, CASContext& context, CallFlags_t flags, const ARGS& args )
+	{
+		CASMethod method( function, context, pThis );
+
+		if( !method.IsValid() || !CallFunction( method, flags, args ) || !method.HasFinished() )
+			return false;
+
+		returnValue = method.GetReturnValue<T>();
+
+		return true;
+	}
+
+private:
+	CASMethodReturnFunctor& operator=( const CASMethodReturnFunctor& ) = delete;
+};
+
+/**
+*	Performs a call with statically typed arguments, and reads the return value.
+*	Do not use directly.
+*/
+template<typename T, typename... ARGS, typename... FUNCARGS>
+inline bool TypedCallAndReturnFunc( asIScriptContext* pContext, CallFlags_t flags, asIScriptFunction* pFunction, T& returnValue, FUNCARGS&&... args )
+{
+	assert( pFunction );
+
+	if( !pFunction || !ValidateTypedCall<ARGS...>( *pFunction ) || !ValidateReturnType<T>( *pFunction ) )
+		return false;
+
+	const CASTypedArguments<ARGS...> arguments( std::forward<FUNCARGS>( args )... );
+
+	return VCall( CASFunctionReturnFunctor<T>( returnValue ), pContext, flags, pFunction, arguments );
+}
+
+/**
+*	@copydoc TypedCallAndReturnFunc( asIScriptContext*, CallFlags_t, asIScriptFunction*, T&, FUNCARGS&&... )
+*/
+template<typename T, typename... ARGS, typename... FUNCARGS>
+inline bool TypedCallAndReturnFunc( void* pThis, asIScriptContext* pContext, CallFlags_t flags, asIScriptFunction* pFunction, T& returnValue, FUNCARGS&&... args )
+{
+	assert( pFunction );
+
+	if( !pFunction || !ValidateTypedCall<ARGS...>( *pFunction ) || !ValidateReturnType<T>( *pFunction ) )
+		return false;
+
+	const CASTypedArguments<ARGS...> arguments( std::forward<FUNCARGS>( args )... );
+
+	return VCall( CASMethodReturnFunctor<T>( pThis, returnValue ), pContext, flags, pFunction, arguments );
+}
+
+#define __TYPED_ARG_PARAM typename NonDeduced<ARGS>::Type_t... args
+
+/*
+*	Implement calls for statically typed arguments. These must be called with the argument types listed explicitly, e.g. as::Call<int, const std::string&>( pFunction, 1, szName ).
+*	Argument types are mapped to script types at compile time using as::ArgumentTraits, and the function's parameters are validated once per function.
+*	Arguments are set directly on the context, without looking up parameter types or decoding varargs.
+*/
+template<typename... ARGS>
+inline bool Call( asIScriptContext* pContext, CallFlags_t flags, asIScriptFunction* pFunction, __TYPED_ARG_PARAM )
+{
+	return TypedCallFunc<ARGS...>( pContext, flags, pFunction, args... );
+}
+
+template<typename... ARGS>
+inline bool Call( CallFlags_t flags, asIScriptFunction* pFunction, __TYPED_ARG_PARAM )
+{
+	return TypedCallFunc<ARGS...>( static_cast<asIScriptContext*>( nullptr ), flags, pFunction, args... );
+}
+
+template<typename... ARGS>
+inline bool Call( asIScriptContext* pContext, asIScriptFunction* pFunction, __TYPED_ARG_PARAM )
+{
+	return TypedCallFunc<ARGS...>( pContext, CallFlag::NONE, pFunction, args... );
+}
+
+template<typename... ARGS>
+inline bool Call( asIScriptFunction* pFunction, __TYPED_ARG_PARAM )
+{
+	return TypedCallFunc<ARGS...>( static_cast<asIScriptContext*>( nullptr ), CallFlag::NONE, pFunction, args... );
+}
+
+template<typename... ARGS>
+inline bool Call( void* pThis, asIScriptContext* pContext, CallFlags_t flags, asIScriptFunction* pFunction, __TYPED_ARG_PARAM )
+{
+	return TypedCallFunc<ARGS...>( pThis, pContext, flags, pFunction, args... );
+}
+
+template<typename... ARGS>
+inline bool Call( void* pThis, CallFlags_t flags, asIScriptFunction* pFunction, __TYPED_ARG_PARAM )
+{
+	return TypedCallFunc<ARGS...>( pThis, nullptr, flags, pFunction, args... );
+}
+
+template<typename... ARGS>
+inline bool Call( void* pThis, asIScriptContext* pContext, asIScriptFunction* pFunction, __TYPED_ARG_PARAM )
+{
+	return TypedCallFunc<ARGS...>( pThis, pContext, CallFlag::NONE, pFunction, args... );
+}
+
+template<typename... ARGS>
+inline bool Call( void* pThis, asIScriptFunction* pFunction, __TYPED_ARG_PARAM )
+{
+	return TypedCallFunc<ARGS...>( pThis, nullptr, CallFlag::NONE, pFunction, args... );
+}
+
+/*
+*	Implement calls that return a value. These must be called with the return type and argument types listed explicitly, e.g. as::CallAndReturn<int, float>( pFunction, iResult, 1.0f ).
+*	The return type is validated once per function, like the argument types, after which the return value is read from the context without any type lookups.
+*/
+template<typename T, typename... ARGS>
+inline bool CallAndReturn( asIScriptContext* pContext, CallFlags_t flags, asIScriptFunction* pFunction, T& returnValue, __TYPED_ARG_PARAM )
+{
+	return TypedCallAndReturnFunc<T, ARGS...>( pContext, flags, pFunction, returnValue, args... );
+}
+
+template<typename T, typename... ARGS>
+inline bool CallAndReturn( asIScriptContext* pContext, asIScriptFunction* pFunction, T& returnValue, __TYPED_ARG_PARAM )
+{
+	return TypedCallAndReturnFunc<T, ARGS...>( pContext, CallFlag::NONE, pFunction, returnValue, args... );
+}
+
+template<typename T, typename... ARGS>
+inline bool CallAndReturn( asIScriptFunction* pFunction, T& returnValue, __TYPED_ARG_PARAM )
+{
+	return TypedCallAndReturnFunc<T, ARGS...>( static_cast<asIScriptContext*>( nullptr ), CallFlag::NONE, pFunction, returnValue, args... );
+}
+
+template<typename T, typename... ARGS>
+inline bool CallAndReturn( void* pThis, asIScriptContext* pContext, CallFlags_t flags, asIScriptFunction* pFunction, T& returnValue, __TYPED_ARG_PARAM )
+{
+	return TypedCallAndReturnFunc<T, ARGS...>( pThis, pContext, flags, pFunction, returnValue, args... );
+}
+
+template<typename T, typename... ARGS>
+inline bool CallAndReturn( void* pThis, asIScriptContext* pContext, asIScriptFunction* pFunction, T& returnValue, __TYPED_ARG_PARAM )
+{
+	return TypedCallAndReturnFunc<T, ARGS...>( pThis, pContext, CallFlag::NONE, pFunction, returnValue, args... );
+}
+
+template<typename T, typename... ARGS>
+inline bool CallAndReturn( void* pThis, asIScriptFunction* pFunction, T& returnValue, __TYPED_ARG_PARAM )
+{
+	return TypedCallAndReturnFunc<T, ARGS...>( pThis, nullptr, CallFlag::NONE, pFunction, returnValue, args... );
+}
+
 /*
 *	Clean up macros
 */
@@ -581,6 +1101,7 @@ __IMPLEMENT_CALL_SIMPLE( Call, VCallFunc, __VA_ARG_PARAM, list, __BEGIN_VA_LIST,
 #undef __VA_ARG_PARAM
 #undef __BEGIN_VA_LIST
 #undef __END_VA_LIST
+#undef __TYPED_ARG_PARAM
 }
 
 /** @} */
@@ -22,6 +22,13 @@ enum CallFlag : CallFlags_t
 	*	No flags.
 	*/
 	NONE = 0,
+
+	/**
+	*	If the call is nested in a script call on the same context and the function raises an exception,
+	*	the exception is raised in the calling script as well.
+	*	The calling script's context can't be used for any more calls after that, so event callers stop calling hooks.
+	*/
+	PROPAGATE_EXCEPTION = 1 << 0,
 };
 }
 
@@ -0,0 +1,155 @@
+#ifndef WRAPPER_ASRETURNTRAITS_H
+#define WRAPPER_ASRETURNTRAITS_H
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <angelscript.h>
+
+#include "AngelscriptUtils/ASUtilsConfig.h"
+
+#include "AngelscriptUtils/util/ASLogging.h"
+#include "AngelscriptUtils/util/ASUtil.h"
+
+/**
+*	@addtogroup ASCallable
+*
+*	@{
+*/
+
+namespace as
+{
+/**
+*	Maps a C++ type to the Angelscript return type it is read from.
+*	Specializations must provide:
+*	static const char* GetDeclaration(): the script declaration of the return type, e.g. "int" or "string".
+*	static bool IsCompatible( asIScriptEngine& engine, const int iTypeId, const asDWORD uiTypeModifiers ): whether a script return type can be read as this type.
+*	static T Get( asIScriptContext& context ): reads the return value from a context that has finished executing. Must not check the return type.
+*
+*	Specialize this for application types that should be returned from scripts.
+*	@tparam T C++ type.
+*/
+template<typename T, typename ENABLE = void>
+struct ReturnTraits;
+
+/**
+*	Defines return traits for a primitive type, returned by value.
+*	@param type C++ type.
+*	@param decl Script type declaration.
+*	@param typeId Script type id.
+*	@param getter asIScriptContext method used to read the return value.
+*/
+#define __AS_PRIMITIVE_RETURN_TRAITS( type, decl, typeId, getter )											\
+template<>																									\
+struct ReturnTraits<type>																					\
+{																											\
+	static const char* GetDeclaration() { return decl; }													\
+																											\
+	static bool IsCompatible( asIScriptEngine&, const int iTypeId, const asDWORD uiTypeModifiers )			\
+	{																										\
+		return iTypeId == typeId && uiTypeModifiers == asTM_NONE;											\
+	}																										\
+																											\
+	static type Get( asIScriptContext& context )															\
+	{																										\
+		return static_cast<type>( context.getter() );														\
+	}																										\
+}
+
+__AS_PRIMITIVE_RETURN_TRAITS( bool, "bool", asTYPEID_BOOL, GetReturnByte );
+__AS_PRIMITIVE_RETURN_TRAITS( int8_t, "int8", asTYPEID_INT8, GetReturnByte );
+__AS_PRIMITIVE_RETURN_TRAITS( int16_t, "int16", asTYPEID_INT16, GetReturnWord );
+__AS_PRIMITIVE_RETURN_TRAITS( int32_t, "int", asTYPEID_INT32, GetReturnDWord );
+__AS_PRIMITIVE_RETURN_TRAITS( int64_t, "int64", asTYPEID_INT64, GetReturnQWord );
+__AS_PRIMITIVE_RETURN_TRAITS( uint8_t, "uint8", asTYPEID_UINT8, GetReturnByte );
+__AS_PRIMITIVE_RETURN_TRAITS( uint16_t, "uint16", asTYPEID_UINT16, GetReturnWord );
+__AS_PRIMITIVE_RETURN_TRAITS( uint32_t, "uint", asTYPEID_UINT32, GetReturnDWord );
+__AS_PRIMITIVE_RETURN_TRAITS( uint64_t, "uint64", asTYPEID_UINT64, GetReturnQWord );
+__AS_PRIMITIVE_RETURN_TRAITS( float, "float", asTYPEID_FLOAT, GetReturnFloat );
+__AS_PRIMITIVE_RETURN_TRAITS( double, "double", asTYPEID_DOUBLE, GetReturnDouble );
+
+#undef __AS_PRIMITIVE_RETURN_TRAITS
+
+/**
+*	Enums are returned as 32 bit integers.
+*	Any script enum is accepted, since the script enum that corresponds to T is not known.
+*/
+template<typename T>
+struct ReturnTraits<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+	static_assert( sizeof( T ) == sizeof( asDWORD ), "Enum return types must be 32 bits" );
+
+	static const char* GetDeclaration() { return "enum"; }
+
+	static bool IsCompatible( asIScriptEngine&, const int iTypeId, const asDWORD uiTypeModifiers )
+	{
+		return as::IsEnum( iTypeId ) && uiTypeModifiers == asTM_NONE;
+	}
+
+	static T Get( asIScriptContext& context )
+	{
+		return static_cast<T>( context.GetReturnDWord() );
+	}
+};
+
+/**
+*	Strings are returned by value, and copied out of the context.
+*/
+template<>
+struct ReturnTraits<std::string>
+{
+	static const char* GetDeclaration() { return "string"; }
+
+	static bool IsCompatible( asIScriptEngine& engine, const int iTypeId, const asDWORD uiTypeModifiers )
+	{
+		return iTypeId == engine.GetTypeIdByDecl( "string" ) && uiTypeModifiers == asTM_NONE;
+	}
+
+	static std::string Get( asIScriptContext& context )
+	{
+		auto pString = reinterpret_cast<const std::string*>( context.GetReturnObject() );
+
+		//There is no return object if the function did not finish.
+		return pString ? *pString : std::string();
+	}
+};
+
+/**
+*	Checks whether a function's return value can be read as the given type.
+*	The result is cached in the function's user data, so the return type is only inspected
+*	the first time the function is used with a given type.
+*	@param function Function to check.
+*	@tparam T C++ return type.
+*	@return true if the return type matches, false otherwise.
+*/
+template<typename T>
+bool ValidateReturnType( asIScriptFunction& function )
+{
+	//The address of this variable identifies the return type.
+	static const char returnTypeTag = 0;
+
+	void* const pTag = const_cast<char*>( &returnTypeTag );
+
+	if( function.GetUserData( ASUTILS_RETURN_TYPE_USERDATA_ID ) == pTag )
+		return true;
+
+	asDWORD uiTypeModifiers;
+	const int iTypeId = function.GetReturnTypeId( &uiTypeModifiers );
+
+	if( !ReturnTraits<T>::IsCompatible( *function.GetEngine(), iTypeId, uiTypeModifiers ) )
+	{
+		as::log->error( "as::ValidateReturnType: Function \"{}\" does not return {}",
+						as::FormatFunctionName( function ), ReturnTraits<T>::GetDeclaration() );
+		return false;
+	}
+
+	function.SetUserData( pTag, ASUTILS_RETURN_TYPE_USERDATA_ID );
+
+	return true;
+}
+}
+
+/** @} */
+
+#endif //WRAPPER_ASRETURNTRAITS_H
@@ -0,0 +1,241 @@
+#include <cassert>
+#include <cstring>
+
+#include "AngelscriptUtils/util/ASLogging.h"
+#include "AngelscriptUtils/util/ASUtil.h"
+#include "AngelscriptUtils/util/ContextUtils.h"
+
+#include "CASArgumentBlock.h"
+
+bool CASArgumentBlock::Add( const bool bValue )
+{
+	ArgumentValue value;
+
+	value.byte = bValue ? 1 : 0;
+
+	return AddPrimitive( asTYPEID_BOOL, value );
+}
+
+bool CASArgumentBlock::Add( const int8_t iValue )
+{
+	ArgumentValue value;
+
+	value.byte = static_cast<asBYTE>( iValue );
+
+	return AddPrimitive( asTYPEID_INT8, value );
+}
+
+bool CASArgumentBlock::Add( const int16_t iValue )
+{
+	ArgumentValue value;
+
+	value.word = static_cast<asWORD>( iValue );
+
+	return AddPrimitive( asTYPEID_INT16, value );
+}
+
+bool CASArgumentBlock::Add( const int32_t iValue )
+{
+	ArgumentValue value;
+
+	value.dword = static_cast<asDWORD>( iValue );
+
+	return AddPrimitive( asTYPEID_INT32, value );
+}
+
+bool CASArgumentBlock::Add( const int64_t iValue )
+{
+	ArgumentValue value;
+
+	value.qword = static_cast<asQWORD>( iValue );
+
+	return AddPrimitive( asTYPEID_INT64, value );
+}
+
+bool CASArgumentBlock::Add( const uint8_t uiValue )
+{
+	ArgumentValue value;
+
+	value.byte = uiValue;
+
+	return AddPrimitive( asTYPEID_UINT8, value );
+}
+
+bool CASArgumentBlock::Add( const uint16_t uiValue )
+{
+	ArgumentValue value;
+
+	value.word = uiValue;
+
+	return AddPrimitive( asTYPEID_UINT16, value );
+}
+
+bool CASArgumentBlock::Add( const uint32_t uiValue )
+{
+	ArgumentValue value;
+
+	value.dword = uiValue;
+
+	return AddPrimitive( asTYPEID_UINT32, value );
+}
+
+bool CASArgumentBlock::Add( const uint64_t uiValue )
+{
+	ArgumentValue value;
+
+	value.qword = uiValue;
+
+	return AddPrimitive( asTYPEID_UINT64, value );
+}
+
+bool CASArgumentBlock::Add( const float flValue )
+{
+	ArgumentValue value;
+
+	value.flValue = flValue;
+
+	return AddPrimitive( asTYPEID_FLOAT, value );
+}
+
+bool CASArgumentBlock::Add( const double dValue )
+{
+	ArgumentValue value;
+
+	value.dValue = dValue;
+
+	return AddPrimitive( asTYPEID_DOUBLE, value );
+}
+
+bool CASArgumentBlock::Add( std::string szValue )
+{
+	if( m_uiCount >= MAX_ARGUMENTS )
+		return false;
+
+	auto& arg = m_Arguments[ m_uiCount++ ];
+
+	arg.iTypeId = asTYPEID_VOID;
+	arg.bIsString = true;
+	arg.value.qword = m_Strings.size();
+
+	m_Strings.emplace_back( std::move( szValue ) );
+
+	return true;
+}
+
+bool CASArgumentBlock::Add( const char* const pszValue )
+{
+	assert( pszValue );
+
+	return Add( std::string( pszValue ? pszValue : "" ) );
+}
+
+bool CASArgumentBlock::AddPrimitive( const int iTypeId, const ArgumentValue& value )
+{
+	if( m_uiCount >= MAX_ARGUMENTS )
+		return false;
+
+	auto& arg = m_Arguments[ m_uiCount++ ];
+
+	arg.iTypeId = iTypeId;
+	arg.bIsString = false;
+	arg.value = value;
+
+	return true;
+}
+
+bool CASArgumentBlock::SetArguments( const asIScriptFunction& targetFunc, asIScriptContext& context ) const
+{
+	const asUINT uiArgCount = targetFunc.GetParamCount();
+
+	if( uiArgCount != m_uiCount )
+	{
+		const auto szFunctionName = as::FormatFunctionName( targetFunc );
+
+		as::log->critical( "CASArgumentBlock::SetArguments: argument count for function '{}' is incorrect: expected {}, got {}!",
+						   szFunctionName, uiArgCount, m_uiCount );
+
+		return false;
+	}
+
+	auto& engine = *context.GetEngine();
+
+	int iTypeId;
+	asDWORD uiFlags;
+
+	for( asUINT uiIndex = 0; uiIndex < uiArgCount; ++uiIndex )
+	{
+		if( targetFunc.GetParam( uiIndex, &iTypeId, &uiFlags ) < 0 )
+			return false;
+
+		if( !SetArgument( engine, context, uiIndex, iTypeId, uiFlags ) )
+			return false;
+	}
+
+	return true;
+}
+
+bool CASArgumentBlock::SetArgument( asIScriptEngine& engine, asIScriptContext& context, const asUINT uiIndex, const int iTypeId, const asDWORD uiFlags ) const
+{
+	auto& arg = m_Arguments[ uiIndex ];
+
+	if( arg.bIsString )
+	{
+		auto pType = engine.GetTypeInfoById( iTypeId );
+
+		if( !pType || strcmp( pType->GetName(), "string" ) != 0 || ( iTypeId & asTYPEID_OBJHANDLE ) )
+		{
+			as::log->critical( "CASArgumentBlock::SetArgument: Argument {} is a string, parameter is not, aborting!", uiIndex );
+			return false;
+		}
+
+		auto& szString = m_Strings[ static_cast<size_t>( arg.value.qword ) ];
+
+		if( uiFlags & asTM_OUTREF )
+			return context.SetArgAddress( uiIndex, &szString ) >= 0;
+
+		return context.SetArgObject( uiIndex, &szString ) >= 0;
+	}
+
+	//Primitive type taken by reference. Must be an exact match.
+	if( uiFlags & ( asTM_INREF | asTM_OUTREF ) )
+	{
+		if( iTypeId != arg.iTypeId && !( as::IsEnum( iTypeId ) && arg.iTypeId == asTYPEID_INT32 ) )
+		{
+			as::log->critical( "CASArgumentBlock::SetArgument: Argument {} type does not match reference parameter, aborting!", uiIndex );
+			return false;
+		}
+
+		return context.SetArgAddress( uiIndex, &arg.value ) >= 0;
+	}
+
+	asINT64 iValue;
+	double dValue;
+
+	if( !ctx::ConvertInputArgToLargest( arg.iTypeId, arg.value, iValue, dValue ) )
+		return false;
+
+	switch( iTypeId )
+	{
+	case asTYPEID_BOOL:
+	case asTYPEID_INT8:
+	case asTYPEID_UINT8:	return context.SetArgByte( uiIndex, static_cast<asBYTE>( iValue ) ) >= 0;
+	case asTYPEID_INT16:
+	case asTYPEID_UINT16:	return context.SetArgWord( uiIndex, static_cast<asWORD>( iValue ) ) >= 0;
+	case asTYPEID_INT32:
+	case asTYPEID_UINT32:	return context.SetArgDWord( uiIndex, static_cast<asDWORD>( iValue ) ) >= 0;
+	case asTYPEID_INT64:
+	case asTYPEID_UINT64:	return context.SetArgQWord( uiIndex, static_cast<asQWORD>( iValue ) ) >= 0;
+
+	case asTYPEID_FLOAT:	return context.SetArgFloat( uiIndex, static_cast<float>( dValue ) ) >= 0;
+	case asTYPEID_DOUBLE:	return context.SetArgDouble( uiIndex, dValue ) >= 0;
+
+	default:
+		{
+			if( as::IsEnum( iTypeId ) )
+				return context.SetArgDWord( uiIndex, static_cast<asDWORD>( iValue ) ) >= 0;
+
+			as::log->critical( "CASArgumentBlock::SetArgument: Argument {} is a primitive type, parameter is not, aborting!", uiIndex );
+			return false;
+		}
+	}
+}
@@ -0,0 +1,212 @@
+#ifndef WRAPPER_CASARGUMENTBLOCK_H
+#define WRAPPER_CASARGUMENTBLOCK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <angelscript.h>
+
+#include "CASArguments.h"
+
+/**
+*	@addtogroup ASArguments
+*
+*	@{
+*/
+
+/**
+*	A list of arguments that does not depend on a script engine.
+*	Only primitive types and strings can be stored. Values are copied into the block, so it can be created on any thread and used later.
+*	Arguments are converted to the function's parameter types when they are set on a context.
+*/
+class CASArgumentBlock final
+{
+public:
+	/**
+	*	Maximum number of arguments that can be stored.
+	*/
+	static const size_t MAX_ARGUMENTS = 8;
+
+public:
+	CASArgumentBlock() = default;
+	~CASArgumentBlock() = default;
+
+	CASArgumentBlock( const CASArgumentBlock& other ) = default;
+	CASArgumentBlock& operator=( const CASArgumentBlock& other ) = default;
+
+	CASArgumentBlock( CASArgumentBlock&& other )
+		: m_uiCount( other.m_uiCount )
+		, m_Strings( std::move( other.m_Strings ) )
+	{
+		for( size_t uiIndex = 0; uiIndex < m_uiCount; ++uiIndex )
+			m_Arguments[ uiIndex ] = other.m_Arguments[ uiIndex ];
+
+		other.m_uiCount = 0;
+	}
+
+	CASArgumentBlock& operator=( CASArgumentBlock&& other )
+	{
+		if( this != &other )
+		{
+			m_uiCount = other.m_uiCount;
+			m_Strings = std::move( other.m_Strings );
+
+			for( size_t uiIndex = 0; uiIndex < m_uiCount; ++uiIndex )
+				m_Arguments[ uiIndex ] = other.m_Arguments[ uiIndex ];
+
+			other.m_uiCount = 0;
+		}
+
+		return *this;
+	}
+
+	/**
+	*	Creates a block containing the given arguments.
+	*	@param args Arguments. Each argument must be accepted by one of the Add overloads.
+	*/
+	template<typename... ARGS>
+	static CASArgumentBlock Create( ARGS&&... args )
+	{
+		static_assert( sizeof...( ARGS ) <= MAX_ARGUMENTS, "Too many arguments for CASArgumentBlock" );
+
+		CASArgumentBlock block;
+
+		int dummy[] = { 0, ( block.Add( std::forward<ARGS>( args ) ), 0 )... };
+
+		( void ) dummy;
+
+		return block;
+	}
+
+	/**
+	*	@return The number of arguments.
+	*/
+	size_t GetArgumentCount() const { return m_uiCount; }
+
+	/**
+	*	@return Whether the argument at the given index is a string.
+	*/
+	bool IsString( const size_t uiIndex ) const { return m_Arguments[ uiIndex ].bIsString; }
+
+	/**
+	*	@return The type id of the argument at the given index, or asTYPEID_VOID if it is a string.
+	*/
+	int GetTypeId( const size_t uiIndex ) const { return m_Arguments[ uiIndex ].iTypeId; }
+
+	/**
+	*	@return The value of the primitive argument at the given index.
+	*/
+	const ArgumentValue& GetValue( const size_t uiIndex ) const { return m_Arguments[ uiIndex ].value; }
+
+	/**
+	*	@copydoc GetValue( const size_t ) const
+	*/
+	ArgumentValue& GetValue( const size_t uiIndex ) { return m_Arguments[ uiIndex ].value; }
+
+	/**
+	*	@return The value of the string argument at the given index.
+	*/
+	const std::string& GetString( const size_t uiIndex ) const { return m_Strings[ static_cast<size_t>( m_Arguments[ uiIndex ].value.qword ) ]; }
+
+	/**
+	*	@copydoc GetString( const size_t ) const
+	*/
+	std::string& GetString( const size_t uiIndex ) { return m_Strings[ static_cast<size_t>( m_Arguments[ uiIndex ].value.qword ) ]; }
+
+	/**
+	*	Removes all arguments.
+	*/
+	void Clear()
+	{
+		m_uiCount = 0;
+		m_Strings.clear();
+	}
+
+	/**
+	*	Adds an argument.
+	*	@return true on success, false if the block is full.
+	*/
+	bool Add( const bool bValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const int8_t iValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const int16_t iValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const int32_t iValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const int64_t iValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const uint8_t uiValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const uint16_t uiValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const uint32_t uiValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const uint64_t uiValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const float flValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const double dValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( std::string szValue );
+
+	/** @copydoc Add( const bool ) */
+	bool Add( const char* const pszValue );
+
+	/**
+	*	Adds a primitive argument.
+	*	@param iTypeId Primitive type id, from asTYPEID_BOOL up to and including asTYPEID_DOUBLE.
+	*	@param value Value.
+	*	@return true on success, false if the block is full.
+	*/
+	bool AddPrimitive( const int iTypeId, const ArgumentValue& value );
+
+	/**
+	*	Sets the arguments on a prepared context. Arguments are converted to the function's parameter types.
+	*	Output references write to storage owned by this block.
+	*	@param targetFunc Target function.
+	*	@param context Context.
+	*	@return true on success, false otherwise.
+	*/
+	bool SetArguments( const asIScriptFunction& targetFunc, asIScriptContext& context ) const;
+
+private:
+	bool SetArgument( asIScriptEngine& engine, asIScriptContext& context, const asUINT uiIndex, const int iTypeId, const asDWORD uiFlags ) const;
+
+private:
+	/**
+	*	A single argument. Strings store the index of the string in m_Strings.
+	*/
+	struct Argument final
+	{
+		int iTypeId;
+		bool bIsString;
+
+		ArgumentValue value;
+	};
+
+	//Mutable so output references can be written to.
+	mutable Argument m_Arguments[ MAX_ARGUMENTS ];
+
+	size_t m_uiCount = 0;
+
+	mutable std::vector<std::string> m_Strings;
+};
+
+/** @} */
+
+#endif //WRAPPER_CASARGUMENTBLOCK_H
@@ -1,9 +1,9 @@
 #include <cassert>
 #include <cstdarg>
+#include <utility>
 
 #include <angelscript.h>
 
-#include "AngelscriptUtils/CASManager.h"
 #include "AngelscriptUtils/util/ASLogging.h"
 #include "AngelscriptUtils/util/ASUtil.h"
 #include "AngelscriptUtils/util/ContextUtils.h"
@@ -27,6 +27,42 @@ CASArgument& CASArgument::operator=( const CASArgument& other )
 	return *this;
 }
 
+CASArgument::CASArgument( CASArgument&& other )
+	: m_iTypeId( other.m_iTypeId )
+	, m_ArgType( other.m_ArgType )
+	, m_Value( other.m_Value )
+	, m_pEngine( other.m_pEngine )
+	, m_bBorrowed( other.m_bBorrowed )
+{
+	other.m_iTypeId = -1;
+	other.m_ArgType = ArgType::NONE;
+	other.m_Value = ArgumentValue();
+	other.m_pEngine = nullptr;
+	other.m_bBorrowed = false;
+}
+
+CASArgument& CASArgument::operator=( CASArgument&& other )
+{
+	if( this != &other )
+	{
+		Reset();
+
+		m_iTypeId = other.m_iTypeId;
+		m_ArgType = other.m_ArgType;
+		m_Value = other.m_Value;
+		m_pEngine = other.m_pEngine;
+		m_bBorrowed = other.m_bBorrowed;
+
+		other.m_iTypeId = -1;
+		other.m_ArgType = ArgType::NONE;
+		other.m_Value = ArgumentValue();
+		other.m_pEngine = nullptr;
+		other.m_bBorrowed = false;
+	}
+
+	return *this;
+}
+
 void* CASArgument::GetArgumentAsPointer() const
 {
 	if( !HasValue() )
@@ -55,6 +91,7 @@ bool CASArgument::Set( asIScriptEngine& engine, const int iTypeId, const ArgType
 
 	m_iTypeId = iTypeId;
 	m_ArgType = type;
+	m_pEngine = &engine;
 
 	if( bCopy )
 	{
@@ -98,9 +135,27 @@ bool CASArgument::Set( asIScriptEngine& engine, const int iTypeId, const ArgType
 	return bSuccess;
 }
 
-bool CASArgument::Set( const int iTypeId, const ArgType::ArgType type, const ArgumentValue& value, const bool bCopy )
+bool CASArgument::Set( const int iTypeId, const ArgType::ArgType type, const ArgumentValue& value, const bool )
 {
-	return Set( *CASManager::GetActiveManager()->GetEngine(), iTypeId, type, value, bCopy );
+	Reset();
+
+	if( type == ArgType::NONE )
+		return true;
+
+	if( type == ArgType::VALUE || type == ArgType::REF )
+	{
+		as::log->critical( "CASArgument::Set: Object arguments require an engine!" );
+		return false;
+	}
+
+	m_iTypeId = iTypeId;
+	m_ArgType = type;
+
+	//Primitive type or enum, just copy
+	if( type != ArgType::VOID )
+		m_Value = value;
+
+	return true;
 }
 
 bool CASArgument::Set( const CASArgument& other )
@@ -108,22 +163,54 @@ bool CASArgument::Set( const CASArgument& other )
 	if( this == &other )
 		return true;
 
+	if( other.m_pEngine )
+		return Set( *other.m_pEngine, other.GetTypeId(), other.GetArgumentType(), other.GetArgumentValue(), true );
+
 	return Set( other.GetTypeId(), other.GetArgumentType(), other.GetArgumentValue(), true );
 }
 
+bool CASArgument::Borrow( asIScriptEngine& engine, const int iTypeId, const ArgType::ArgType type, const ArgumentValue& value )
+{
+	Reset();
+
+	if( type == ArgType::NONE )
+		return true;
+
+	m_iTypeId = iTypeId;
+	m_ArgType = type;
+	m_pEngine = &engine;
+
+	if( type != ArgType::VOID )
+		m_Value = value;
+
+	m_bBorrowed = type == ArgType::VALUE || type == ArgType::REF;
+
+	return true;
+}
+
+bool CASArgument::Borrow( const CASArgument& other )
+{
+	if( this == &other )
+		return true;
+
+	if( other.m_pEngine )
+		return Borrow( *other.m_pEngine, other.GetTypeId(), other.GetArgumentType(), other.GetArgumentValue() );
+
+	//Primitive types and enums don't need an engine
+	return Set( other.GetTypeId(), other.GetArgumentType(), other.GetArgumentValue() );
+}
+
 void CASArgument::Reset()
 {
 	if( HasValue() )
 	{
-		//Release reference if needed
-		if( !as::IsPrimitive( m_iTypeId ) && !as::IsEnum( m_iTypeId ) )
+		//Release reference if needed. Borrowed values are owned by someone else.
+		if( !m_bBorrowed && !as::IsPrimitive( m_iTypeId ) && !as::IsEnum( m_iTypeId ) )
 		{
-			auto pEngine = CASManager::GetActiveManager()->GetEngine();
-
-			asITypeInfo* pType = pEngine->GetTypeInfoById( m_iTypeId );
+			asITypeInfo* pType = m_pEngine ? m_pEngine->GetTypeInfoById( m_iTypeId ) : nullptr;
 
 			if( pType )
-				pEngine->ReleaseScriptObject( m_Value.pValue, pType );
+				m_pEngine->ReleaseScriptObject( m_Value.pValue, pType );
 			else
 			{
 				as::log->critical( "CASArgument::Reset: Failed to get object type!" );
@@ -133,12 +220,68 @@ void CASArgument::Reset()
 		m_iTypeId = -1;
 		m_ArgType = ArgType::NONE;
 		m_Value = ArgumentValue();
+		m_pEngine = nullptr;
+		m_bBorrowed = false;
+	}
+}
+
+CASArgumentList::CASArgumentList( CASArgumentList&& other )
+{
+	*this = std::move( other );
+}
+
+CASArgumentList& CASArgumentList::operator=( CASArgumentList&& other )
+{
+	if( this != &other )
+	{
+		Clear();
+
+		if( other.m_HeapArguments )
+		{
+			m_HeapArguments = std::move( other.m_HeapArguments );
+		}
+		else
+		{
+			for( size_t uiIndex = 0; uiIndex < other.m_uiCount; ++uiIndex )
+				m_InlineArguments[ uiIndex ] = std::move( other.m_InlineArguments[ uiIndex ] );
+		}
+
+		m_uiCount = other.m_uiCount;
+
+		other.m_uiCount = 0;
+	}
+
+	return *this;
+}
+
+void CASArgumentList::Resize( const size_t uiCount )
+{
+	Clear();
+
+	if( uiCount > MAX_INLINE_ARGUMENTS )
+		m_HeapArguments.reset( new CASArgument[ uiCount ] );
+
+	m_uiCount = uiCount;
+}
+
+void CASArgumentList::Clear()
+{
+	if( m_HeapArguments )
+	{
+		m_HeapArguments.reset();
 	}
+	else
+	{
+		for( size_t uiIndex = 0; uiIndex < m_uiCount; ++uiIndex )
+			m_InlineArguments[ uiIndex ].Reset();
+	}
+
+	m_uiCount = 0;
 }
 
-CASArguments::CASArguments( asIScriptGeneric& arguments, size_t uiStartIndex )
+CASArguments::CASArguments( asIScriptGeneric& arguments, size_t uiStartIndex, const bool bBorrowValues )
 {
-	SetArguments( arguments, uiStartIndex );
+	SetArguments( arguments, uiStartIndex, bBorrowValues );
 }
 
 CASArguments::CASArguments( asIScriptFunction& targetFunc, va_list list )
@@ -169,13 +312,26 @@ CASArguments& CASArguments::operator=( const CASArguments& other )
 	return *this;
 }
 
+CASArguments::CASArguments( CASArguments&& other )
+	: CASRefCountedBaseClass()
+	, m_Arguments( std::move( other.m_Arguments ) )
+{
+}
+
+CASArguments& CASArguments::operator=( CASArguments&& other )
+{
+	m_Arguments = std::move( other.m_Arguments );
+
+	return *this;
+}
+
 void CASArguments::Assign( const CASArguments& other )
 {
 	if( this != &other )
 	{
 		Clear();
 
-		m_Arguments.resize( other.GetArgumentCount() );
+		m_Arguments.Resize( other.GetArgumentCount() );
 
 		if( other.HasArguments() )
 		{
@@ -184,13 +340,10 @@ void CASArguments::Assign( const CASArguments& other )
 			//Failure is unlikely, but there might be issues copying between lists that don't occur in init from scripts
 			bool bSuccess = true;
 
-			auto pEngine = CASManager::GetActiveManager()->GetEngine();
-
-			for( size_t uiIndex = 0; uiIndex < m_Arguments.size() && bSuccess; ++uiIndex )
+			//Each argument is copied using its own engine, so lists can be copied between engines.
+			for( size_t uiIndex = 0; uiIndex < m_Arguments.GetCount() && bSuccess; ++uiIndex )
 			{
-				const CASArgument& sourceArg = sourceArgs[ uiIndex ];
-
-				bSuccess = m_Arguments[ uiIndex ].Set( *pEngine, sourceArg.GetTypeId(), sourceArg.GetArgumentType(), sourceArg.GetArgumentValue(), true );
+				bSuccess = m_Arguments[ uiIndex ].Set( sourceArgs[ uiIndex ] );
 			}
 
 			if( !bSuccess )
@@ -201,21 +354,20 @@ void CASArguments::Assign( const CASArguments& other )
 
 void CASArguments::Clear()
 {
-	m_Arguments.clear();
-	m_Arguments.shrink_to_fit();
+	m_Arguments.Clear();
 }
 
 const CASArgument* CASArguments::GetArgument( const size_t uiIndex ) const
 {
-	assert( uiIndex < m_Arguments.size() );
+	assert( uiIndex < m_Arguments.GetCount() );
 
-	if(  uiIndex >= m_Arguments.size() )
+	if(  uiIndex >= m_Arguments.GetCount() )
 		return nullptr;
 
 	return &m_Arguments[ uiIndex ];
 }
 
-bool CASArguments::SetArguments( asIScriptGeneric& arguments, size_t uiStartIndex )
+bool CASArguments::SetArguments( asIScriptGeneric& arguments, size_t uiStartIndex, const bool bBorrowValues )
 {
 	const size_t uiArgCount = static_cast<size_t>( arguments.GetArgCount() );
 
@@ -230,22 +382,23 @@ bool CASArguments::SetArguments( asIScriptGeneric& arguments, size_t uiStartInde
 
 	bool bSuccess = true;
 
-	Arguments_t args( uiTargetArgs );
+	//Arguments are written directly into this object's storage so no temporary list is needed.
+	m_Arguments.Resize( uiTargetArgs );
+
+	auto& args = m_Arguments;
 
-	auto pEngine = CASManager::GetActiveManager()->GetEngine();
+	auto pEngine = arguments.GetEngine();
 
 	for( asUINT uiIndex = 0; uiIndex < uiTargetArgs && bSuccess; ++uiIndex )
 	{
 		void* pData = arguments.GetArgAddress( uiIndex + uiStartIndex );
 		int iTypeId = arguments.GetArgTypeId( uiIndex + uiStartIndex );
 
-		bSuccess = ctx::SetArgument( *pEngine, pData, iTypeId, args[ uiIndex ] );
+		bSuccess = ctx::SetArgument( *pEngine, pData, iTypeId, args[ uiIndex ], bBorrowValues );
 	}
 
-	if( bSuccess )
-	{
-		m_Arguments = std::move( args );
-	}
+	if( !bSuccess )
+		Clear();
 
 	return bSuccess;
 }
@@ -260,11 +413,13 @@ bool CASArguments::SetArguments( asIScriptFunction& targetFunc, va_list list )
 
 	const asUINT uiArgCount = targetFunc.GetParamCount();
 
-	Arguments_t args( uiArgCount );
+	m_Arguments.Resize( uiArgCount );
+
+	auto& args = m_Arguments;
 
 	bool bSuccess = true;
 
-	auto pEngine = CASManager::GetActiveManager()->GetEngine();
+	auto pEngine = targetFunc.GetEngine();
 
 	int iTypeId;
 	asDWORD uiFlags;
@@ -304,10 +459,8 @@ bool CASArguments::SetArguments( asIScriptFunction& targetFunc, va_list list )
 		}
 	}
 
-	if( bSuccess )
-	{
-		m_Arguments = std::move( args );
-	}
+	if( !bSuccess )
+		Clear();
 
 	return bSuccess;
 }
\ No newline at end of file
@@ -1,7 +1,8 @@
 #ifndef ANGELSCRIPT_CASARGUMENTS_H
 #define ANGELSCRIPT_CASARGUMENTS_H
 
-#include <vector>
+#include <cstddef>
+#include <memory>
 
 #include "AngelscriptUtils/util/CASBaseClass.h"
 
@@ -72,6 +73,9 @@ struct ArgumentValue final
 
 /**
 *	Represents a single argument.
+*	An argument normally owns its value: value types are copies, and reference types hold a reference.
+*	A borrowed argument points to a value whose lifetime is guaranteed by the caller, and does not release it.
+*	Object arguments remember the engine that they were set with, so arguments from different engines can be used at the same time.
 */
 class CASArgument final
 {
@@ -88,15 +92,30 @@ public:
 	~CASArgument();
 
 	/**
-	*	Copy constructor.
+	*	Copy constructor. The copy always owns its value, even if other is borrowed.
 	*/
 	CASArgument( const CASArgument& other );
 
 	/**
-	*	Assignment operator.
+	*	Assignment operator. The copy always owns its value, even if other is borrowed.
 	*/
 	CASArgument& operator=( const CASArgument& other );
 
+	/**
+	*	Move constructor. Transfers the value and its ownership; other is left with no value.
+	*/
+	CASArgument( CASArgument&& other );
+
+	/**
+	*	Move assignment operator. Transfers the value and its ownership; other is left with no value.
+	*/
+	CASArgument& operator=( CASArgument&& other );
+
+	/**
+	*	@return The engine that the value belongs to, or null if the argument was set without one.
+	*/
+	inline asIScriptEngine* GetEngine() const { return m_pEngine; }
+
 	/**
 	*	@return The type id.
 	*/
@@ -122,6 +141,11 @@ public:
 	*/
 	bool HasValue() const { return !( m_ArgType & ( ArgType::VOID | ArgType::NONE ) ); }
 
+	/**
+	*	@return Whether the value is borrowed, and won't be released by this argument.
+	*/
+	bool IsBorrowed() const { return m_bBorrowed; }
+
 	/**
 	*	Gets the address of the argument.
 	*	For read access only!
@@ -141,18 +165,39 @@ public:
 	bool Set( asIScriptEngine& engine, const int iTypeId, const ArgType::ArgType type, const ArgumentValue& value, const bool bCopy = false );
 
 	/**
-	*	Same as the other version, but will retrieve the engine from the active manager instead.
+	*	Same as the other version, but without an engine. Only primitive types and enums can be set this way.
+	*	@return true on success, false if the type is an object type, or otherwise failed.
 	*	@see Set( asIScriptEngine& engine, const int iTypeId, const ArgType::ArgType type, const ArgumentValue& value, const bool bCopy = false )
 	*/
 	bool Set( const int iTypeId, const ArgType::ArgType type, const ArgumentValue& value, const bool bCopy = false );
 
 	/**
 	*	Sets the argument to that of the given argument. The value is copy constructed, or in the case of ref types, a reference is added.
+	*	Uses the other argument's engine.
 	*	@param other Argument to copy.
 	*	@return true on success, false otherwise.
 	*/
 	bool Set( const CASArgument& other );
 
+	/**
+	*	Sets the argument to the given value and type without taking ownership of it. Objects are not copied or AddRef'd, and are not released by Reset.
+	*	The caller must guarantee that the value outlives this argument, or the argument is reset first.
+	*	Primitive types and enums are always copied.
+	*	@param engine Engine that the value belongs to. Used if the argument is copied.
+	*	@param iTypeId Type Id.
+	*	@param type Argument type.
+	*	@param value Value to borrow.
+	*	@return true on success, false otherwise.
+	*/
+	bool Borrow( asIScriptEngine& engine, const int iTypeId, const ArgType::ArgType type, const ArgumentValue& value );
+
+	/**
+	*	Borrows the value of the given argument. Has the same requirements as the other version.
+	*	@param other Argument whose value to borrow.
+	*	@return true on success, false otherwise.
+	*/
+	bool Borrow( const CASArgument& other );
+
 	/**
 	*	Resets the argument. It is left with no value.
 	*/
@@ -168,15 +213,106 @@ private:
 
 	//The actual value.
 	ArgumentValue m_Value = ArgumentValue();
+
+	//Engine that owns the value. Used to release it without relying on a global engine.
+	asIScriptEngine* m_pEngine = nullptr;
+
+	//Whether the value is owned by someone else.
+	bool m_bBorrowed = false;
+};
+
+/**
+*	List of arguments with inline storage for a small number of arguments.
+*	Lists of up to MAX_INLINE_ARGUMENTS arguments don't allocate any memory; larger lists are stored on the heap.
+*/
+class CASArgumentList final
+{
+public:
+	/**
+	*	Number of arguments that are stored inline. Matches the maximum number of varargs used by the scheduler.
+	*/
+	static const size_t MAX_INLINE_ARGUMENTS = 8;
+
+public:
+	/**
+	*	Default constructor. Creates an empty list.
+	*/
+	CASArgumentList() = default;
+
+	/**
+	*	Destructor.
+	*/
+	~CASArgumentList() = default;
+
+	/**
+	*	Move constructor. Heap storage is taken over, inline arguments are moved.
+	*/
+	CASArgumentList( CASArgumentList&& other );
+
+	/**
+	*	Move assignment operator. Heap storage is taken over, inline arguments are moved.
+	*/
+	CASArgumentList& operator=( CASArgumentList&& other );
+
+	/**
+	*	@return The number of arguments.
+	*/
+	size_t GetCount() const { return m_uiCount; }
+
+	/**
+	*	@return Whether the list is empty.
+	*/
+	bool IsEmpty() const { return m_uiCount == 0; }
+
+	/**
+	*	@return Whether the arguments are stored on the heap.
+	*/
+	bool IsHeapAllocated() const { return m_HeapArguments != nullptr; }
+
+	CASArgument* begin() { return GetArguments(); }
+	CASArgument* end() { return GetArguments() + m_uiCount; }
+
+	const CASArgument* begin() const { return GetArguments(); }
+	const CASArgument* end() const { return GetArguments() + m_uiCount; }
+
+	CASArgument& operator[]( const size_t uiIndex ) { return GetArguments()[ uiIndex ]; }
+	const CASArgument& operator[]( const size_t uiIndex ) const { return GetArguments()[ uiIndex ]; }
+
+	/**
+	*	Clears the list, and then resizes it to contain the given number of arguments. The arguments have no value.
+	*	@param uiCount Number of arguments.
+	*/
+	void Resize( const size_t uiCount );
+
+	/**
+	*	Clears the list. Heap storage, if any, is freed.
+	*/
+	void Clear();
+
+private:
+	CASArgument* GetArguments() { return m_HeapArguments ? m_HeapArguments.get() : m_InlineArguments; }
+	const CASArgument* GetArguments() const { return m_HeapArguments ? m_HeapArguments.get() : m_InlineArguments; }
+
+private:
+	CASArgument m_InlineArguments[ MAX_INLINE_ARGUMENTS ];
+
+	std::unique_ptr<CASArgument[]> m_HeapArguments;
+
+	size_t m_uiCount = 0;
+
+private:
+	CASArgumentList( const CASArgumentList& ) = delete;
+	CASArgumentList& operator=( const CASArgumentList& ) = delete;
 };
 
 /**
 *	This class can store a variable number of arguments.
+*	Up to CASArgumentList::MAX_INLINE_ARGUMENTS arguments are stored without allocating memory.
 */
 class CASArguments final : public CASRefCountedBaseClass
 {
 public:
-	typedef std::vector<CASArgument> Arguments_t;
+	typedef CASArgumentList Arguments_t;
 
 public:
 
@@ -189,9 +325,10 @@ public:
 	*	Constructor. Creates a list of arguments based on the given generic call instance.
 	*	@param arguments Generic call instance.
 	*	@param uiStartIndex The index of the first argument to use.
-	*	@see SetArguments( asIScriptGeneric& arguments, size_t uiStartIndex )
+	*	@param bBorrowValues Whether value type arguments should be borrowed instead of copied.
+	*	@see SetArguments( asIScriptGeneric& arguments, size_t uiStartIndex, const bool bBorrowValues )
 	*/
-	CASArguments( asIScriptGeneric& arguments, size_t uiStartIndex = 0 );
+	CASArguments( asIScriptGeneric& arguments, size_t uiStartIndex = 0, const bool bBorrowValues = false );
 
 	/**
 	*	Constructor. Creates a list of arguments based on the given function, and the given varargs pointer.
@@ -218,6 +355,16 @@ public:
 	*/
 	CASArguments& operator=( const CASArguments& other );
 
+	/**
+	*	Move constructor. Takes over the arguments of other without copying them. The reference count is not transferred.
+	*/
+	CASArguments( CASArguments&& other );
+
+	/**
+	*	Move assignment operator. Takes over the arguments of other without copying them. The reference count is not transferred.
+	*/
+	CASArguments& operator=( CASArguments&& other );
+
 	/**
 	*	Copies the arguments from the given arguments object to this one.
 	*/
@@ -236,7 +383,7 @@ public:
 	/**
 	*	@return The number of arguments.
 	*/
-	size_t GetArgumentCount() const { return m_Arguments.size(); }
+	size_t GetArgumentCount() const { return m_Arguments.GetCount(); }
 
 	/**
 	*	Gets the argument at the given index.
@@ -247,21 +394,23 @@ public:
 	/**
 	*	@return Whether there are any arguments in this object.
 	*/
-	bool HasArguments() const { return !m_Arguments.empty(); }
+	bool HasArguments() const { return !m_Arguments.IsEmpty(); }
 
 	/**
 	*	Sets the list of arguments to that of the given generic call instance.
 	*	@param arguments Generic call instance.
 	*	@param uiStartIndex The index of the first argument to use.
-	*	@return true on success, false otherwise.
+	*	@param bBorrowValues Whether value type arguments should be borrowed instead of copied.
+	*		Only use this if this object does not outlive the generic call.
+	*	@return true on success, false otherwise. On failure, the list is cleared.
 	*/
-	bool SetArguments( asIScriptGeneric& arguments, size_t uiStartIndex = 0 );
+	bool SetArguments( asIScriptGeneric& arguments, size_t uiStartIndex = 0, const bool bBorrowValues = false );
 
 	/**
 	*	Sets the list of arguments to that of the given function, and the given varargs pointer.
 	*	@param targetFunc Function whose arguments will be used for type info.
 	*	@param list Pointer to the arguments to use.
-	*	@return true on success, false otherwise.
+	*	@return true on success, false otherwise. On failure, the list is cleared.
 	*/
 	bool SetArguments( asIScriptFunction& targetFunc, va_list list );
 
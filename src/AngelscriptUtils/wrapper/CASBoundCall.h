@@ -0,0 +1,250 @@
+#ifndef WRAPPER_CASBOUNDCALL_H
+#define WRAPPER_CASBOUNDCALL_H
+
+#include <cassert>
+
+#include <angelscript.h>
+
+#include "AngelscriptUtils/util/ASLogging.h"
+#include "AngelscriptUtils/util/ASUtil.h"
+#include "AngelscriptUtils/util/ContextUtils.h"
+
+#include "ASCallable.h"
+#include "ASReturnTraits.h"
+#include "CASTypedArguments.h"
+
+/**
+*	@addtogroup ASCallable
+*
+*	@{
+*/
+
+/**
+*	A call to a script function that is resolved and validated once, and can then be invoked any number of times.
+*	Intended for entry points that are called very often, like Think or Touch functions.
+*
+*	The function's parameters are checked against ARGS when the call is bound. Invoking it only prepares the context,
+*	writes the argument values and executes; no parameter types are looked up and no varargs are decoded.
+*	@tparam ARGS C++ argument types. Each type must have an as::ArgumentTraits specialization.
+*/
+template<typename... ARGS>
+class CASBoundCall final
+{
+public:
+	typedef CASTypedArguments<ARGS...> Arguments_t;
+
+public:
+	/**
+	*	Creates an unbound call.
+	*/
+	CASBoundCall() = default;
+
+	/**
+	*	Binds a function.
+	*	@param function Function to bind. Is AddRef'd if it is compatible.
+	*/
+	explicit CASBoundCall( asIScriptFunction& function )
+	{
+		Bind( function );
+	}
+
+	/**
+	*	Finds a function by declaration and binds it.
+	*	@param module Module to search in.
+	*	@param pszDeclaration Function declaration.
+	*/
+	CASBoundCall( asIScriptModule& module, const char* const pszDeclaration )
+	{
+		Bind( module, pszDeclaration );
+	}
+
+	~CASBoundCall()
+	{
+		Unbind();
+	}
+
+	/**
+	*	@return Whether a function is bound.
+	*/
+	bool IsBound() const { return m_pFunction != nullptr; }
+
+	/**
+	*	@return The bound function, or null if no function is bound.
+	*/
+	asIScriptFunction* GetFunction() const { return m_pFunction; }
+
+	/**
+	*	Binds a function. The previous function, if any, is unbound.
+	*	@param function Function to bind. Is AddRef'd if it is compatible.
+	*	@return true if the function's parameters match ARGS, false otherwise.
+	*/
+	bool Bind( asIScriptFunction& function )
+	{
+		Unbind();
+
+		if( !Arguments_t::IsCompatibleWith( function ) )
+		{
+			as::log->error( "CASBoundCall::Bind: Function \"{}\" cannot be called with arguments ({})",
+							as::FormatFunctionName( function ), Arguments_t::GetDeclaration() );
+			return false;
+		}
+
+		m_pFunction = &function;
+		m_pFunction->AddRef();
+
+		m_iReturnTypeId = m_pFunction->GetReturnTypeId( &m_uiReturnFlags );
+
+		return true;
+	}
+
+	/**
+	*	Finds a function by declaration and binds it. The previous function, if any, is unbound.
+	*	@param module Module to search in.
+	*	@param pszDeclaration Function declaration.
+	*	@return true if the function exists and its parameters match ARGS, false otherwise.
+	*/
+	bool Bind( asIScriptModule& module, const char* const pszDeclaration )
+	{
+		assert( pszDeclaration );
+
+		Unbind();
+
+		auto pFunction = module.GetFunctionByDecl( pszDeclaration );
+
+		if( !pFunction )
+		{
+			as::log->error( "CASBoundCall::Bind: Couldn't find function \"{}\" in module \"{}\"", pszDeclaration, module.GetName() );
+			return false;
+		}
+
+		return Bind( *pFunction );
+	}
+
+	/**
+	*	Releases the bound function.
+	*/
+	void Unbind()
+	{
+		if( m_pFunction )
+		{
+			m_pFunction->Release();
+			m_pFunction = nullptr;
+		}
+
+		m_iReturnTypeId = asTYPEID_VOID;
+		m_uiReturnFlags = asTM_NONE;
+	}
+
+	/**
+	*	Calls the bound function.
+	*	@param pContext Script context. If null, acquires a context using asIScriptEngine::RequestContext.
+	*	@param args Arguments.
+	*	@return true on success, false otherwise.
+	*/
+	bool Invoke( asIScriptContext* pContext, ARGS... args ) const
+	{
+		if( !m_pFunction )
+			return false;
+
+		const Arguments_t arguments( std::forward<ARGS>( args )... );
+
+		return as::VCallFunc( pContext, CallFlag::NONE, m_pFunction, arguments );
+	}
+
+	/**
+	*	Calls the bound function as a method of the given object.
+	*	@param pThis Object to call the method on.
+	*	@param pContext Script context. If null, acquires a context using asIScriptEngine::RequestContext.
+	*	@param args Arguments.
+	*	@return true on success, false otherwise.
+	*/
+	bool InvokeMethod( void* pThis, asIScriptContext* pContext, ARGS... args ) const
+	{
+		if( !m_pFunction )
+			return false;
+
+		const Arguments_t arguments( std::forward<ARGS>( args )... );
+
+		return as::VCallFunc( pThis, pContext, CallFlag::NONE, m_pFunction, arguments );
+	}
+
+	/**
+	*	Calls the bound function and reads its return value.
+	*	The return type is checked against T the first time the function is used with T; afterwards the value is read from the context directly.
+	*	@param pContext Script context. If null, acquires a context using asIScriptEngine::RequestContext.
+	*	@param[ out ] returnValue Variable that receives the return value.
+	*	@param args Arguments.
+	*	@tparam T C++ return type. Must have an as::ReturnTraits specialization.
+	*	@return true on success, false otherwise.
+	*/
+	template<typename T>
+	bool CallAndReturn( asIScriptContext* pContext, T& returnValue, ARGS... args ) const
+	{
+		if( !m_pFunction || !as::ValidateReturnType<T>( *m_pFunction ) )
+			return false;
+
+		const Arguments_t arguments( std::forward<ARGS>( args )... );
+
+		return as::VCall( as::CASFunctionReturnFunctor<T>( returnValue ), pContext, CallFlag::NONE, m_pFunction, arguments );
+	}
+
+	/**
+	*	Calls the bound function as a method of the given object and reads its return value.
+	*	@param pThis Object to call the method on.
+	*	@see CallAndReturn( asIScriptContext*, T&, ARGS... ) const
+	*/
+	template<typename T>
+	bool CallMethodAndReturn( void* pThis, asIScriptContext* pContext, T& returnValue, ARGS... args ) const
+	{
+		if( !m_pFunction || !as::ValidateReturnType<T>( *m_pFunction ) )
+			return false;
+
+		const Arguments_t arguments( std::forward<ARGS>( args )... );
+
+		return as::VCall( as::CASMethodReturnFunctor<T>( pThis, returnValue ), pContext, CallFlag::NONE, m_pFunction, arguments );
+	}
+
+	/**
+	*	Gets the return value of the last call made on the given context as the given type. Only valid if the context was passed to Invoke, and the call finished.
+	*	The value is read from the context directly; the return type must have been checked with as::ValidateReturnType, or by a previous CallAndReturn.
+	*	@param context Context that the function was invoked on.
+	*	@tparam T C++ return type. Must have an as::ReturnTraits specialization.
+	*	@return The return value.
+	*/
+	template<typename T>
+	T GetReturnValue( asIScriptContext& context ) const
+	{
+		assert( m_pFunction && as::ReturnTraits<T>::IsCompatible( *m_pFunction->GetEngine(), m_iReturnTypeId, m_uiReturnFlags ) );
+		assert( context.GetState() == asEXECUTION_FINISHED );
+
+		return as::ReturnTraits<T>::Get( context );
+	}
+
+	/**
+	*	Gets the return value of the last call made on the given context. Only valid if the context was passed to Invoke.
+	*	@param context Context that the function was invoked on.
+	*	@param pReturnValue Pointer to the variable that will receive the return value. Must match the type being retrieved.
+	*	@return true if the value was successfully retrieved, false otherwise, or if the call did not finish.
+	*/
+	bool GetReturnValue( asIScriptContext& context, void* pReturnValue ) const
+	{
+		if( !m_pFunction || context.GetState() != asEXECUTION_FINISHED )
+			return false;
+
+		return ctx::GetReturnValue( context, m_iReturnTypeId, m_uiReturnFlags, pReturnValue );
+	}
+
+private:
+	asIScriptFunction* m_pFunction = nullptr;
+
+	int m_iReturnTypeId = asTYPEID_VOID;
+	asDWORD m_uiReturnFlags = asTM_NONE;
+
+private:
+	CASBoundCall( const CASBoundCall& ) = delete;
+	CASBoundCall& operator=( const CASBoundCall& ) = delete;
+};
+
+/** @} */
+
+#endif //WRAPPER_CASBOUNDCALL_H
@@ -6,6 +6,14 @@
 
 void CASOwningContext::Release()
 {
+	//The context belongs to the calling script, leave it alone.
+	if( m_bBorrowed )
+	{
+		m_pContext = nullptr;
+		m_bBorrowed = false;
+		return;
+	}
+
 	if( m_pContext )
 	{
 		const auto result = m_pContext->Unprepare();
@@ -42,4 +50,6 @@ void CASOwningContext::ReleaseOwnership()
 	{
 		m_pEngine = nullptr;
 	}
+
+	m_bBorrowed = false;
 }
\ No newline at end of file
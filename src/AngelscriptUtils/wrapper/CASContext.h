@@ -61,11 +61,22 @@ public:
 
 	/**
 	*	Constructor. A context is acquired using asIScriptEngine::RequestContext.
+	*	If nesting is allowed and a script is executing on this thread with a context from the given engine, that context is borrowed instead,
+	*	and calls made with it are nested using asIScriptContext::PushState.
+	*	Only callers that always finish their call before returning to the script should allow nesting;
+	*	a borrowed context can't be kept around, suspended or used after the calling script has resumed.
 	*	@param engine Script engine.
+	*	@param bAllowNesting Whether the active context may be borrowed.
 	*/
-	CASOwningContext( asIScriptEngine& engine )
-		: CASContext( *engine.RequestContext() )
+	CASOwningContext( asIScriptEngine& engine, const bool bAllowNesting = false )
+		: CASContext( GetContextForEngine( engine, bAllowNesting ) )
 	{
+		if( bAllowNesting && m_pContext == asGetActiveContext() )
+		{
+			m_bBorrowed = true;
+			return;
+		}
+
 		m_pEngine = &engine;
 
 		m_pEngine->AddRef();
@@ -89,9 +100,30 @@ public:
 	*/
 	void ReleaseOwnership();
 
+	/**
+	*	@return Whether the context is the active context, borrowed for a nested call. Borrowed contexts are not released.
+	*/
+	bool IsBorrowed() const { return m_bBorrowed; }
+
+private:
+	static asIScriptContext& GetContextForEngine( asIScriptEngine& engine, const bool bAllowNesting )
+	{
+		if( bAllowNesting )
+		{
+			auto pActiveContext = asGetActiveContext();
+
+			if( pActiveContext && pActiveContext->GetEngine() == &engine )
+				return *pActiveContext;
+		}
+
+		return *engine.RequestContext();
+	}
+
 private:
 	//TODO: consider: the engine can be retrieved using m_pContext->GetEngine. All that's needed is a flag that indicates where it came from.
 	asIScriptEngine* m_pEngine = nullptr;
+
+	bool m_bBorrowed = false;
 };
 
 /** @} */
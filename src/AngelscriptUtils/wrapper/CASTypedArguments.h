@@ -0,0 +1,332 @@
+#ifndef WRAPPER_CASTYPEDARGUMENTS_H
+#define WRAPPER_CASTYPEDARGUMENTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <angelscript.h>
+
+/**
+*	@addtogroup ASCallable
+*
+*	@{
+*/
+
+namespace as
+{
+/**
+*	Maps a C++ type to the Angelscript parameter it is passed as.
+*	Specializations must provide:
+*	static const char* GetDeclaration(): the script declaration of the parameter, e.g. "int" or "const string& in".
+*	static bool IsCompatible( asIScriptEngine& engine, const int iTypeId, const asDWORD uiTypeModifiers ): whether a script parameter accepts this type.
+*	static bool Set( asIScriptContext& context, const asUINT uiIndex, T value ): sets the argument on a prepared context.
+*
+*	Specialize this for application types that should be passed to scripts.
+*	@tparam T C++ type.
+*/
+template<typename T, typename ENABLE = void>
+struct ArgumentTraits;
+
+/**
+*	Defines traits for a primitive type, passed by value and as an output reference.
+*	@param type C++ type.
+*	@param decl Script type declaration.
+*	@param typeId Script type id.
+*	@param setter asIScriptContext method used to set the argument by value.
+*	@param setType Type that the setter accepts.
+*/
+#define __AS_PRIMITIVE_ARGUMENT_TRAITS( type, decl, typeId, setter, setType )										\
+template<>																										\
+struct ArgumentTraits<type>																						\
+{																												\
+	static const char* GetDeclaration() { return decl; }														\
+																												\
+	static bool IsCompatible( asIScriptEngine&, const int iTypeId, const asDWORD uiTypeModifiers )				\
+	{																											\
+		return iTypeId == typeId && uiTypeModifiers == asTM_NONE;												\
+	}																											\
+																												\
+	static bool Set( asIScriptContext& context, const asUINT uiIndex, type value )								\
+	{																											\
+		return context.setter( uiIndex, static_cast<setType>( value ) ) >= 0;									\
+	}																											\
+};																												\
+																												\
+template<>																										\
+struct ArgumentTraits<type&>																					\
+{																												\
+	static const char* GetDeclaration() { return decl "& out"; }												\
+																												\
+	static bool IsCompatible( asIScriptEngine&, const int iTypeId, const asDWORD uiTypeModifiers )				\
+	{																											\
+		return iTypeId == typeId && ( uiTypeModifiers & asTM_OUTREF ) != 0;										\
+	}																											\
+																												\
+	static bool Set( asIScriptContext& context, const asUINT uiIndex, type& value )								\
+	{																											\
+		return context.SetArgAddress( uiIndex, &value ) >= 0;													\
+	}																											\
+}
+
+__AS_PRIMITIVE_ARGUMENT_TRAITS( bool, "bool", asTYPEID_BOOL, SetArgByte, asBYTE );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( int8_t, "int8", asTYPEID_INT8, SetArgByte, asBYTE );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( int16_t, "int16", asTYPEID_INT16, SetArgWord, asWORD );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( int32_t, "int", asTYPEID_INT32, SetArgDWord, asDWORD );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( int64_t, "int64", asTYPEID_INT64, SetArgQWord, asQWORD );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( uint8_t, "uint8", asTYPEID_UINT8, SetArgByte, asBYTE );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( uint16_t, "uint16", asTYPEID_UINT16, SetArgWord, asWORD );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( uint32_t, "uint", asTYPEID_UINT32, SetArgDWord, asDWORD );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( uint64_t, "uint64", asTYPEID_UINT64, SetArgQWord, asQWORD );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( float, "float", asTYPEID_FLOAT, SetArgFloat, float );
+__AS_PRIMITIVE_ARGUMENT_TRAITS( double, "double", asTYPEID_DOUBLE, SetArgDouble, double );
+
+#undef __AS_PRIMITIVE_ARGUMENT_TRAITS
+
+/**
+*	Enums are passed as 32 bit integers.
+*	Any script enum is accepted, since the script enum that corresponds to T is not known.
+*/
+template<typename T>
+struct ArgumentTraits<T, typename std::enable_if<std::is_enum<T>::value>::type>
+{
+	static_assert( sizeof( T ) == sizeof( asDWORD ), "Enum arguments must be 32 bits" );
+
+	static const char* GetDeclaration() { return "enum"; }
+
+	static bool IsCompatible( asIScriptEngine&, const int iTypeId, const asDWORD uiTypeModifiers )
+	{
+		//Same check as as::IsEnum. ASUtil.h includes this header, so it can't be used here.
+		return iTypeId > asTYPEID_DOUBLE && ( iTypeId & asTYPEID_MASK_OBJECT ) == 0 && uiTypeModifiers == asTM_NONE;
+	}
+
+	static bool Set( asIScriptContext& context, const asUINT uiIndex, T value )
+	{
+		return context.SetArgDWord( uiIndex, static_cast<asDWORD>( value ) ) >= 0;
+	}
+};
+
+/**
+*	Script object handles. Any script class handle is accepted, since the class that the object must have is not known.
+*	The object's class is checked against the parameter when the argument is set. Null handles are allowed.
+*/
+template<>
+struct ArgumentTraits<asIScriptObject*>
+{
+	static const char* GetDeclaration() { return "class@"; }
+
+	static bool IsCompatible( asIScriptEngine&, const int iTypeId, const asDWORD uiTypeModifiers )
+	{
+		return ( iTypeId & asTYPEID_OBJHANDLE ) && ( iTypeId & asTYPEID_SCRIPTOBJECT ) && uiTypeModifiers == asTM_NONE;
+	}
+
+	static bool Set( asIScriptContext& context, const asUINT uiIndex, asIScriptObject* pObject )
+	{
+		if( pObject )
+		{
+			int iTypeId;
+
+			if( context.GetFunction()->GetParam( uiIndex, &iTypeId ) < 0 ||
+				!context.GetEngine()->IsHandleCompatibleWithObject( pObject, pObject->GetTypeId(), iTypeId ) )
+				return false;
+		}
+
+		//The context adds a reference for the duration of the call.
+		return context.SetArgObject( uiIndex, pObject ) >= 0;
+	}
+};
+
+/**
+*	Strings are passed as const references. The string must remain valid for the duration of the call.
+*/
+template<>
+struct ArgumentTraits<const std::string&>
+{
+	static const char* GetDeclaration() { return "const string& in"; }
+
+	static bool IsCompatible( asIScriptEngine& engine, const int iTypeId, const asDWORD uiTypeModifiers )
+	{
+		return iTypeId == engine.GetTypeIdByDecl( "string" ) && ( uiTypeModifiers & asTM_INREF ) != 0;
+	}
+
+	static bool Set( asIScriptContext& context, const asUINT uiIndex, const std::string& szValue )
+	{
+		return context.SetArgObject( uiIndex, const_cast<std::string*>( &szValue ) ) >= 0;
+	}
+};
+
+/**
+*	Strings passed as output references.
+*/
+template<>
+struct ArgumentTraits<std::string&>
+{
+	static const char* GetDeclaration() { return "string& out"; }
+
+	static bool IsCompatible( asIScriptEngine& engine, const int iTypeId, const asDWORD uiTypeModifiers )
+	{
+		return iTypeId == engine.GetTypeIdByDecl( "string" ) && ( uiTypeModifiers & asTM_OUTREF ) != 0;
+	}
+
+	static bool Set( asIScriptContext& context, const asUINT uiIndex, std::string& szValue )
+	{
+		return context.SetArgAddress( uiIndex, &szValue ) >= 0;
+	}
+};
+
+/**
+*	Helper that applies argument traits to each element of a tuple.
+*	Do not use directly.
+*	@tparam INDEX Number of elements to process.
+*/
+template<size_t INDEX, typename... ARGS>
+struct TypedArgumentsHelper final
+{
+	typedef typename std::tuple_element<INDEX - 1, std::tuple<ARGS...>>::type Type_t;
+
+	static void AppendDeclaration( std::string& szDeclaration )
+	{
+		TypedArgumentsHelper<INDEX - 1, ARGS...>::AppendDeclaration( szDeclaration );
+
+		if( INDEX > 1 )
+			szDeclaration += ", ";
+
+		szDeclaration += ArgumentTraits<Type_t>::GetDeclaration();
+	}
+
+	static bool IsCompatible( asIScriptEngine& engine, const asIScriptFunction& function )
+	{
+		int iTypeId;
+		asDWORD uiTypeModifiers;
+
+		if( function.GetParam( INDEX - 1, &iTypeId, &uiTypeModifiers ) < 0 )
+			return false;
+
+		return TypedArgumentsHelper<INDEX - 1, ARGS...>::IsCompatible( engine, function ) &&
+			ArgumentTraits<Type_t>::IsCompatible( engine, iTypeId, uiTypeModifiers );
+	}
+
+	static bool Set( asIScriptContext& context, const std::tuple<ARGS...>& args )
+	{
+		return TypedArgumentsHelper<INDEX - 1, ARGS...>::Set( context, args ) &&
+			ArgumentTraits<Type_t>::Set( context, INDEX - 1, std::get<INDEX - 1>( args ) );
+	}
+};
+
+template<typename... ARGS>
+struct TypedArgumentsHelper<0, ARGS...> final
+{
+	static void AppendDeclaration( std::string& )
+	{
+	}
+
+	static bool IsCompatible( asIScriptEngine&, const asIScriptFunction& )
+	{
+		return true;
+	}
+
+	static bool Set( asIScriptContext&, const std::tuple<ARGS...>& )
+	{
+		return true;
+	}
+};
+}
+
+/**
+*	Statically typed list of arguments.
+*	Unlike CASArguments, the types are known at compile time, so arguments are set directly on the context without any type lookups.
+*	References are stored as-is, so referenced values must outlive the call.
+*	@tparam ARGS C++ argument types. Each type must have an as::ArgumentTraits specialization.
+*/
+template<typename... ARGS>
+class CASTypedArguments final
+{
+public:
+	typedef std::tuple<ARGS...> Arguments_t;
+
+	typedef as::TypedArgumentsHelper<sizeof...( ARGS ), ARGS...> Helper_t;
+
+public:
+	CASTypedArguments( ARGS... args )
+		: m_Arguments( std::forward<ARGS>( args )... )
+	{
+	}
+
+	CASTypedArguments( const CASTypedArguments& other ) = default;
+
+	/**
+	*	@return The number of arguments.
+	*/
+	static size_t GetArgumentCount() { return sizeof...( ARGS ); }
+
+	/**
+	*	@return The script declaration of the argument list, e.g. "int, const string& in".
+	*/
+	static std::string GetDeclaration()
+	{
+		std::string szDeclaration;
+
+		Helper_t::AppendDeclaration( szDeclaration );
+
+		return szDeclaration;
+	}
+
+	/**
+	*	Checks whether the given function can be called with these arguments.
+	*	This only needs to be done once per function; afterwards arguments can be set without any checks.
+	*	@param function Function to check.
+	*	@return true if the parameters match, false otherwise.
+	*/
+	static bool IsCompatibleWith( const asIScriptFunction& function )
+	{
+		if( function.GetParamCount() != GetArgumentCount() )
+			return false;
+
+		return Helper_t::IsCompatible( *function.GetEngine(), function );
+	}
+
+	/**
+	*	@return The arguments.
+	*/
+	const Arguments_t& GetArguments() const { return m_Arguments; }
+
+	/**
+	*	Sets the arguments on a prepared context. Does not check whether the function's parameters match.
+	*	@param context Context.
+	*	@return true on success, false otherwise.
+	*/
+	bool Set( asIScriptContext& context ) const
+	{
+		return Helper_t::Set( context, m_Arguments );
+	}
+
+private:
+	Arguments_t m_Arguments;
+
+private:
+	CASTypedArguments& operator=( const CASTypedArguments& ) = delete;
+};
+
+namespace ctx
+{
+/**
+*	Sets arguments for a function call.
+*	The function's parameters are not checked; use CASTypedArguments::IsCompatibleWith to validate them once beforehand.
+*	@param targetFunc Target function.
+*	@param context Context.
+*	@param arguments List of arguments.
+*	@return true on success, false otherwise.
+*/
+template<typename... ARGS>
+inline bool SetArguments( const asIScriptFunction&, asIScriptContext& context, const CASTypedArguments<ARGS...>& arguments )
+{
+	return arguments.Set( context );
+}
+}
+
+/** @} */
+
+#endif //WRAPPER_CASTYPEDARGUMENTS_H
@@ -0,0 +1,115 @@
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+#include <angelscript.h>
+
+#undef VOID
+
+#include "AngelscriptUtils/CASManager.h"
+#include "AngelscriptUtils/CASModule.h"
+#include "AngelscriptUtils/event/CASEventManager.h"
+#include "AngelscriptUtils/event/CASEventReplayer.h"
+
+#include "AngelscriptUtils/util/ASExtendAdapter.h"
+#include "AngelscriptUtils/util/ASLogging.h"
+
+#include "AngelscriptUtils/wrapper/ASCallable.h"
+
+#include "CASTestInitializer.h"
+
+/*
+*	Replays a trace recorded by the test program ( AngelscriptUtilsTest --record <file> ) against the test scripts,
+*	and reports how long each event took to call.
+*	Usage: AngelscriptUtilsReplay <file> [--realtime]
+*/
+int main( int argc, char* argv[] )
+{
+	std::string szReplayFilename;
+	auto replayMode = EventReplayMode::FAST;
+
+	for( int iArg = 1; iArg < argc; ++iArg )
+	{
+		if( strcmp( argv[ iArg ], "--realtime" ) == 0 )
+			replayMode = EventReplayMode::REALTIME;
+		else
+			szReplayFilename = argv[ iArg ];
+	}
+
+	if( szReplayFilename.empty() )
+	{
+		std::cout << "Usage: AngelscriptUtilsReplay <file> [--realtime]" << std::endl;
+		return 1;
+	}
+
+	{
+		auto console = std::make_shared<spdlog::sinks::stdout_sink_mt>();
+
+		std::vector<spdlog::sink_ptr> sinks{ console };
+
+		auto logger = spdlog::create( "ASUtils", sinks.begin(), sinks.end() );
+
+		as::log = logger;
+	}
+
+	int iResult = 1;
+
+	CASManager manager;
+
+	CASTestInitializer initializer( manager );
+
+	if( manager.Initialize( initializer ) )
+	{
+		auto pEngine = manager.GetEngine();
+
+		//Build the module the same way the test program does, so the recorded events and hooks match.
+		const auto szDecl = as::CreateExtendBaseclassDeclaration( "CScriptBaseEntity", "IScriptEntity", "CBaseEntity", "BaseEntity" );
+
+		manager.GetModuleManager().AddDescriptor( "MapScript", ModuleAccessMask::MAPSCRIPT, as::ModulePriority::HIGHEST );
+
+		CASTestModuleBuilder builder( szDecl );
+
+		auto pModule = manager.GetModuleManager().BuildModule( "MapScript", "MapModule", builder );
+
+		if( pModule )
+		{
+			//Let the script hook its functions into the events.
+			if( auto pFunction = pModule->GetModule()->GetFunctionByName( "main" ) )
+			{
+				std::string szString = "Replaying\n";
+
+				as::Call( pFunction, &szString, false );
+			}
+
+			CASEventReplayer replayer( *manager.GetEventManager() );
+
+			if( replayer.Load( szReplayFilename ) )
+			{
+				replayer.Replay( *pEngine, replayMode );
+
+				std::cout << "Replayed " << replayer.GetCallCount() << " calls, skipped " << replayer.GetSkippedCount() << std::endl
+					<< replayer.GetReport();
+
+				iResult = 0;
+			}
+			else
+			{
+				std::cout << "Couldn't load trace \"" << szReplayFilename << "\"" << std::endl;
+			}
+
+			manager.GetModuleManager().RemoveModule( pModule );
+		}
+	}
+
+	//Shut down the Angelscript engine, frees all resources.
+	manager.Shutdown();
+
+	spdlog::drop( as::log->name() );
+
+	as::log.reset();
+
+	return iResult;
+}
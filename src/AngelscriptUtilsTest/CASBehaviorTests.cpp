@@ -0,0 +1,625 @@
+#include <cstdarg>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include <angelscript.h>
+
+#include "AngelscriptUtils/CASContextPool.h"
+#include "AngelscriptUtils/CASManager.h"
+#include "AngelscriptUtils/CASModule.h"
+
+#include "AngelscriptUtils/event/CASEvent.h"
+#include "AngelscriptUtils/event/CASEventCaller.h"
+#include "AngelscriptUtils/event/CASEventListener.h"
+#include "AngelscriptUtils/event/CASEventManager.h"
+
+#include "AngelscriptUtils/wrapper/ASCallable.h"
+#include "AngelscriptUtils/wrapper/CASArgumentBlock.h"
+#include "AngelscriptUtils/wrapper/CASArguments.h"
+#include "AngelscriptUtils/wrapper/CASBoundCall.h"
+
+#include "CASBehaviorTests.h"
+#include "CASTestInitializer.h"
+
+namespace
+{
+/**
+*	Sets the arguments for a call to the given function from variable arguments.
+*/
+bool SetArguments( CASArguments& arguments, asIScriptFunction* pFunction, ... )
+{
+	va_list list;
+
+	va_start( list, pFunction );
+
+	const bool bSuccess = arguments.SetArguments( *pFunction, list );
+
+	va_end( list );
+
+	return bSuccess;
+}
+
+/**
+*	@return The reference count of the given object.
+*/
+int GetRefCount( asIScriptObject& object )
+{
+	object.AddRef();
+
+	return object.Release();
+}
+}
+
+bool CASBehaviorTests::Run()
+{
+	std::cout << "Running behavior checks" << std::endl;
+
+	TestTemporaryFunctionEventLookup();
+	TestNestedCalls();
+	TestOwningContextNesting();
+	TestDeferredEventBudget();
+	TestReplacedContextPool();
+	TestTypedArgumentTraits();
+	TestUnhookedEventCall();
+	TestEventLookup();
+	TestEventStats();
+	TestKeyedDispatch();
+	TestUnhookModuleFunctions();
+	TestSuspendedModuleHooks();
+	TestScriptEvent();
+	TestTargetedDispatch();
+	TestTypedCallSignature();
+	TestBoundCall();
+	TestContextPoolReuse();
+	TestInlineArguments();
+	TestArgumentMoves();
+	TestArgumentEngine();
+	TestTypedReturnValues();
+
+	std::cout << "Behavior checks: " << m_uiPassed << " passed, " << m_uiFailed << " failed" << std::endl;
+
+	return m_uiFailed == 0;
+}
+
+void CASBehaviorTests::Check( const char* pszName, const bool bPassed )
+{
+	std::cout << ( bPassed ? "PASS: " : "FAIL: " ) << pszName << std::endl;
+
+	if( bPassed )
+		++m_uiPassed;
+	else
+		++m_uiFailed;
+}
+
+CASEvent* CASBehaviorTests::GetCountEvent() const
+{
+	return m_Manager.GetEventManager()->FindEventByName( "BehaviorCount" );
+}
+
+asIScriptFunction* CASBehaviorTests::GetFunction( const char* pszName ) const
+{
+	return m_Module.GetModule()->GetFunctionByName( pszName );
+}
+
+int* CASBehaviorTests::GetGlobalInt( const char* pszName ) const
+{
+	auto pModule = m_Module.GetModule();
+
+	const auto iIndex = pModule->GetGlobalVarIndexByName( pszName );
+
+	if( iIndex < 0 )
+		return nullptr;
+
+	return reinterpret_cast<int*>( pModule->GetAddressOfGlobalVar( iIndex ) );
+}
+
+void CASBehaviorTests::TestTemporaryFunctionEventLookup()
+{
+	//Temporary functions cache the calling module like any other function. Freeing one must remove it from the module's cache.
+	asIScriptFunction* pFunction = nullptr;
+
+	const auto result = m_Module.GetModule()->CompileFunction( "TemporaryEventLookup",
+		"bool TemporaryEventLookup() { return g_EventManager.FindEventByName( \"Main\" ) !is null; }", 0, 0, &pFunction );
+
+	bool bFound = false;
+
+	if( result >= 0 && pFunction )
+	{
+		as::CallAndReturn( pFunction, bFound );
+
+		pFunction->Release();
+	}
+
+	Check( "A temporary function can look up events", bFound );
+}
+
+void CASBehaviorTests::TestNestedCalls()
+{
+	//The script makes two nested calls with the same callable, and checks its own state afterwards.
+	bool bResult = false;
+
+	if( auto pFunction = m_Module.GetModule()->GetFunctionByName( "TestNestedCalls" ) )
+		as::CallAndReturn( pFunction, bResult );
+
+	Check( "A callable can make more than one nested call, and the calling script's state is restored", bResult );
+}
+
+void CASBehaviorTests::TestOwningContextNesting()
+{
+	bool bResult = false;
+
+	if( auto pFunction = m_Module.GetModule()->GetFunctionByName( "TestOwningContextNesting" ) )
+		as::CallAndReturn( pFunction, bResult );
+
+	Check( "Owning contexts only borrow the calling script's context if nesting is allowed", bResult );
+}
+
+void CASBehaviorTests::TestDeferredEventBudget()
+{
+	auto& eventManager = *m_Manager.GetEventManager();
+
+	const auto uiOldBudget = eventManager.GetDeferredEventBudget();
+
+	eventManager.SetDeferredEventBudget( 2 );
+
+	//3 coalesced entries with different keys, and 1 regular event.
+	testEvent.SetCoalesced( true );
+
+	for( uint64_t uiKey = 0; uiKey < 3; ++uiKey )
+	{
+		eventManager.PostEvent( testEvent, uiKey, CASArgumentBlock::Create( std::string( "Coalesced event\n" ) ) );
+	}
+
+	testEvent.SetCoalesced( false );
+
+	eventManager.PostEvent( testEvent, CASArgumentBlock::Create( std::string( "Deferred event\n" ) ) );
+
+	const auto uiFirstCount = eventManager.ProcessDeferredEvents();
+	const auto uiSecondCount = eventManager.ProcessDeferredEvents();
+	const auto uiThirdCount = eventManager.ProcessDeferredEvents();
+
+	eventManager.SetDeferredEventBudget( uiOldBudget );
+
+	Check( "Coalesced events count towards the deferred event budget", uiFirstCount == 2 && uiSecondCount == 2 && uiThirdCount == 0 );
+}
+
+void CASBehaviorTests::TestReplacedContextPool()
+{
+	auto& pool = *m_Manager.GetContextPool();
+
+	//Replace the manager's pool the way an application would, by setting other context callbacks.
+	bool bDetected;
+
+	{
+		CASContextPool otherPool( *m_Manager.GetEngine() );
+
+		otherPool.Install();
+
+		bDetected = !pool.VerifyInstalled();
+	}
+
+	pool.Install();
+
+	Check( "A replaced context pool is detected", bDetected && pool.VerifyInstalled() );
+}
+
+void CASBehaviorTests::TestTypedArgumentTraits()
+{
+	auto pModule = m_Module.GetModule();
+
+	bool bEnumPassed = false;
+
+	if( auto pFunction = pModule->GetFunctionByName( "TestEnumArgument" ) )
+		as::CallAndReturn<bool, HookReturnCode>( pFunction, bEnumPassed, HookReturnCode::HANDLED );
+
+	Check( "Enums can be passed as typed arguments", bEnumPassed );
+
+	auto pEngine = m_Manager.GetEngine();
+
+	auto pFoo = reinterpret_cast<asIScriptObject*>( pEngine->CreateScriptObject( pModule->GetTypeInfoByName( "Foo" ) ) );
+	auto pLifetime = reinterpret_cast<asIScriptObject*>( pEngine->CreateScriptObject( pModule->GetTypeInfoByName( "Lifetime" ) ) );
+
+	bool bHandlePassed = false;
+	bool bWrongClassRejected = false;
+
+	if( auto pFunction = pModule->GetFunctionByName( "TestHandleArgument" ) )
+	{
+		if( pFoo && pLifetime )
+		{
+			as::CallAndReturn<bool, asIScriptObject*>( pFunction, bHandlePassed, pFoo );
+
+			bool bResult = false;
+
+			bWrongClassRejected = !as::CallAndReturn<bool, asIScriptObject*>( pFunction, bResult, pLifetime );
+		}
+	}
+
+	if( pFoo )
+		pFoo->Release();
+
+	if( pLifetime )
+		pLifetime->Release();
+
+	Check( "Script object handles can be passed as typed arguments, and must match the parameter's class", bHandlePassed && bWrongClassRejected );
+}
+
+void CASBehaviorTests::TestUnhookedEventCall()
+{
+	auto pEvent = GetCountEvent();
+
+	auto& pool = *m_Manager.GetContextPool();
+
+	const auto before = pool.GetStats();
+
+	const auto result = pEvent ? CASEventCaller().Call( *pEvent, m_Manager.GetEngine(), 1 ) : HookCallResult::FAILED;
+
+	const auto after = pool.GetStats();
+
+	Check( "Calling an event without hooks doesn't acquire a context",
+		result == HookCallResult::NONE_HANDLED && before.uiHits + before.uiMisses == after.uiHits + after.uiMisses );
+}
+
+void CASBehaviorTests::TestEventLookup()
+{
+	auto& eventManager = *m_Manager.GetEventManager();
+
+	Check( "Events can be looked up by name",
+		eventManager.FindEventByName( "Main" ) == &testEvent && GetCountEvent() && !eventManager.FindEventByName( "NonExistentEvent" ) );
+}
+
+void CASBehaviorTests::TestEventStats()
+{
+	auto pEvent = GetCountEvent();
+	auto pHook = GetFunction( "CountingHook" );
+
+	bool bCounted = false;
+
+	if( pEvent && pHook && pEvent->AddFunction( pHook ) )
+	{
+		pEvent->ResetStats();
+		pEvent->SetStatsEnabled( true );
+
+		CASEventCaller caller;
+
+		caller.Call( *pEvent, m_Manager.GetEngine(), 1 );
+		caller.Call( *pEvent, m_Manager.GetEngine(), 1 );
+
+		pEvent->SetStatsEnabled( false );
+
+		const auto& hooks = pEvent->GetHookList();
+
+		bCounted = pEvent->GetStats().uiCallCount == 2 && hooks.GetHookCount() == 1 && hooks.GetHookState( 0 ).GetStats().uiCallCount == 2;
+
+		pEvent->RemoveAllFunctions();
+		pEvent->ResetStats();
+	}
+
+	Check( "Event and hook statistics count calls", bCounted );
+}
+
+void CASBehaviorTests::TestKeyedDispatch()
+{
+	auto pEvent = GetCountEvent();
+	auto pHook = GetFunction( "CountingHook" );
+	auto pOtherHook = GetFunction( "OtherCountingHook" );
+	auto piHookCalls = GetGlobalInt( "g_iHookCalls" );
+	auto piOtherHookCalls = GetGlobalInt( "g_iOtherHookCalls" );
+
+	bool bTargeted = false;
+
+	if( pEvent && pHook && pOtherHook && piHookCalls && piOtherHookCalls )
+	{
+		pEvent->AddFunction( pHook, 1 );
+		pEvent->AddFunction( pOtherHook, 2 );
+
+		*piHookCalls = *piOtherHookCalls = 0;
+
+		CASEventCaller( 1 ).Call( *pEvent, m_Manager.GetEngine(), 1 );
+
+		bTargeted = *piHookCalls == 1 && *piOtherHookCalls == 0;
+
+		CASEventCaller( 3 ).Call( *pEvent, m_Manager.GetEngine(), 1 );
+
+		bTargeted = bTargeted && *piHookCalls == 1 && *piOtherHookCalls == 0;
+
+		pEvent->RemoveAllFunctions();
+	}
+
+	Check( "Keyed calls only call hooks with a matching key", bTargeted );
+}
+
+void CASBehaviorTests::TestUnhookModuleFunctions()
+{
+	//This also removes the test script's hooks on the Main event, so checks that run after this one must not depend on them.
+	auto pEvent = GetCountEvent();
+	auto pHook = GetFunction( "CountingHook" );
+
+	bool bUnhooked = false;
+
+	if( pEvent && pHook && pEvent->AddFunction( pHook ) && pEvent->HasFunctionsOfModule( &m_Module ) )
+	{
+		m_Manager.GetEventManager()->UnhookModuleFunctions( &m_Module );
+
+		bUnhooked = !pEvent->IsHooked() && !testEvent.HasFunctionsOfModule( &m_Module );
+
+		pEvent->RemoveAllFunctions();
+	}
+
+	Check( "Unhooking a module's functions removes its hooks from all events", bUnhooked );
+}
+
+void CASBehaviorTests::TestSuspendedModuleHooks()
+{
+	auto pEvent = GetCountEvent();
+	auto pHook = GetFunction( "CountingHook" );
+	auto piHookCalls = GetGlobalInt( "g_iHookCalls" );
+
+	bool bSkipped = false;
+	bool bResumed = false;
+
+	if( pEvent && pHook && piHookCalls && pEvent->AddFunction( pHook ) )
+	{
+		*piHookCalls = 0;
+
+		m_Module.SetHooksEnabled( false );
+
+		CASEventCaller().Call( *pEvent, m_Manager.GetEngine(), 1 );
+
+		bSkipped = *piHookCalls == 0 && pEvent->IsHooked();
+
+		m_Module.SetHooksEnabled( true );
+
+		CASEventCaller().Call( *pEvent, m_Manager.GetEngine(), 1 );
+
+		bResumed = *piHookCalls == 1;
+
+		pEvent->RemoveAllFunctions();
+	}
+
+	Check( "Hooks of a suspended module are skipped, and called again once it is resumed", bSkipped && bResumed );
+}
+
+void CASBehaviorTests::TestScriptEvent()
+{
+	bool bResult = false;
+
+	if( auto pFunction = GetFunction( "TestScriptEvent" ) )
+		as::CallAndReturn( pFunction, bResult );
+
+	auto pEvent = GetCountEvent();
+
+	Check( "Scripts can create, hook and call their own events", bResult && pEvent && !pEvent->IsHooked() );
+}
+
+void CASBehaviorTests::TestTargetedDispatch()
+{
+	auto pEvent = GetCountEvent();
+	auto pHook = GetFunction( "CountingHook" );
+	auto piHookCalls = GetGlobalInt( "g_iHookCalls" );
+	auto pPluginDescriptor = m_Manager.GetModuleManager().FindDescriptorByName( "Plugin" );
+
+	bool bTargeted = false;
+
+	if( pEvent && pHook && piHookCalls && pPluginDescriptor && pEvent->AddFunction( pHook ) )
+	{
+		auto pEngine = m_Manager.GetEngine();
+
+		*piHookCalls = 0;
+
+		CASEventCaller( m_Module ).Call( *pEvent, pEngine, 1 );
+		CASEventCaller( m_Module.GetDescriptor() ).Call( *pEvent, pEngine, 1 );
+		CASEventCaller( *pPluginDescriptor ).Call( *pEvent, pEngine, 1 );
+
+		bTargeted = *piHookCalls == 2;
+
+		pEvent->RemoveAllFunctions();
+	}
+
+	Check( "Targeted calls only call hooks of the given module or descriptor", bTargeted );
+}
+
+void CASBehaviorTests::TestTypedCallSignature()
+{
+	bool bMismatchRejected = false;
+	bool bCalled = false;
+
+	if( auto pFunction = GetFunction( "AddOne" ) )
+	{
+		bMismatchRejected = !as::Call<float>( pFunction, 1.0f );
+
+		int iResult = 0;
+
+		bCalled = as::CallAndReturn<int, int>( pFunction, iResult, 1 ) && iResult == 2;
+	}
+
+	Check( "Typed calls check the function's signature", bMismatchRejected && bCalled );
+}
+
+void CASBehaviorTests::TestBoundCall()
+{
+	auto& module = *m_Module.GetModule();
+
+	CASBoundCall<int> call;
+
+	int iFirst = 0;
+	int iSecond = 0;
+
+	const bool bCalled = call.Bind( module, "int AddOne(int)" ) &&
+		call.CallAndReturn( nullptr, iFirst, 1 ) && call.CallAndReturn( nullptr, iSecond, 10 ) &&
+		iFirst == 2 && iSecond == 11;
+
+	CASBoundCall<float> mismatchedCall;
+
+	const bool bMismatchRejected = !mismatchedCall.Bind( module, "int AddOne(int)" ) && !mismatchedCall.IsBound();
+
+	Check( "Bound calls can be called repeatedly, and reject functions with other parameters", bCalled && bMismatchRejected );
+}
+
+void CASBehaviorTests::TestContextPoolReuse()
+{
+	auto pEngine = m_Manager.GetEngine();
+	auto& pool = *m_Manager.GetContextPool();
+
+	bool bReused = false;
+
+	if( auto pContext = pEngine->RequestContext() )
+	{
+		pEngine->ReturnContext( pContext );
+
+		const auto before = pool.GetStats();
+
+		auto pReusedContext = pEngine->RequestContext();
+
+		const auto after = pool.GetStats();
+
+		if( pReusedContext )
+			pEngine->ReturnContext( pReusedContext );
+
+		bReused = pReusedContext == pContext && after.uiHits == before.uiHits + 1 && after.uiMisses == before.uiMisses &&
+			pool.GetStats().uiInUse == before.uiInUse;
+	}
+
+	Check( "Returned contexts are reused by the next request", bReused );
+}
+
+void CASBehaviorTests::TestInlineArguments()
+{
+	auto pSumEight = GetFunction( "SumEight" );
+	auto pSumNine = GetFunction( "SumNine" );
+	auto piSum = GetGlobalInt( "g_iArgumentSum" );
+
+	bool bInline = false;
+	bool bHeap = false;
+
+	if( pSumEight && pSumNine && piSum )
+	{
+		CASArguments eight;
+
+		if( SetArguments( eight, pSumEight, 1, 2, 3, 4, 5, 6, 7, 8 ) )
+		{
+			bInline = !eight.GetArgumentList().IsHeapAllocated() && eight.GetArgument( 7 )->GetArgumentValue().dword == 8 &&
+				as::CallArgs( pSumEight, eight ) && *piSum == 36;
+		}
+
+		CASArguments nine;
+
+		if( SetArguments( nine, pSumNine, 1, 2, 3, 4, 5, 6, 7, 8, 9 ) )
+		{
+			bHeap = nine.GetArgumentList().IsHeapAllocated() && nine.GetArgument( 8 )->GetArgumentValue().dword == 9 &&
+				as::CallArgs( pSumNine, nine ) && *piSum == 45;
+		}
+	}
+
+	Check( "Argument lists are stored inline up to the maximum, and on the heap beyond it", bInline && bHeap );
+}
+
+void CASBehaviorTests::TestArgumentMoves()
+{
+	auto pFunction = GetFunction( "TakeLifetime" );
+
+	auto pLifetime = reinterpret_cast<asIScriptObject*>( m_Manager.GetEngine()->CreateScriptObject( m_Module.GetModule()->GetTypeInfoByName( "Lifetime" ) ) );
+
+	bool bMoved = false;
+	bool bCopied = false;
+	bool bBorrowed = false;
+	bool bReleased = false;
+
+	if( pFunction && pLifetime )
+	{
+		const int iRefCount = GetRefCount( *pLifetime );
+
+		{
+			CASArguments arguments;
+
+			if( SetArguments( arguments, pFunction, pLifetime ) && GetRefCount( *pLifetime ) == iRefCount + 1 )
+			{
+				CASArguments movedArguments( std::move( arguments ) );
+
+				bMoved = movedArguments.GetArgumentCount() == 1 && GetRefCount( *pLifetime ) == iRefCount + 1;
+
+				{
+					CASArguments copiedArguments( movedArguments );
+
+					bCopied = GetRefCount( *pLifetime ) == iRefCount + 2;
+				}
+
+				CASArgument argument( *movedArguments.GetArgument( 0 ) );
+				CASArgument movedArgument( std::move( argument ) );
+
+				bMoved = bMoved && GetRefCount( *pLifetime ) == iRefCount + 2;
+
+				CASArgument borrowedArgument;
+
+				bBorrowed = borrowedArgument.Borrow( movedArgument ) && borrowedArgument.IsBorrowed() &&
+					GetRefCount( *pLifetime ) == iRefCount + 2;
+			}
+		}
+
+		bReleased = GetRefCount( *pLifetime ) == iRefCount;
+	}
+
+	if( pLifetime )
+		pLifetime->Release();
+
+	Check( "Moving and borrowing arguments doesn't add references to objects, copying does", bMoved && bCopied && bBorrowed && bReleased );
+}
+
+void CASBehaviorTests::TestArgumentEngine()
+{
+	auto pEngine = m_Manager.GetEngine();
+	auto pType = m_Module.GetModule()->GetTypeInfoByName( "Lifetime" );
+
+	auto pLifetime = pType ? reinterpret_cast<asIScriptObject*>( pEngine->CreateScriptObject( pType ) ) : nullptr;
+
+	bool bSetWithEngine = false;
+	bool bRejectedWithoutEngine = false;
+	bool bPrimitiveWithoutEngine = false;
+
+	if( pLifetime )
+	{
+		ArgumentValue value;
+
+		value.pValue = pLifetime;
+
+		CASArgument argument;
+
+		bSetWithEngine = argument.Set( *pEngine, pType->GetTypeId(), ArgType::REF, value, true ) &&
+			argument.GetEngine() == pEngine && argument.GetArgumentValue().pValue == pLifetime;
+
+		argument.Reset();
+
+		bRejectedWithoutEngine = !argument.Set( pType->GetTypeId(), ArgType::REF, value, true );
+
+		value.dword = 10;
+
+		bPrimitiveWithoutEngine = argument.Set( asTYPEID_INT32, ArgType::PRIMITIVE, value ) && !argument.GetEngine() &&
+			argument.GetArgumentValue().dword == 10;
+
+		pLifetime->Release();
+	}
+
+	Check( "Object arguments are set with the engine they belong to, and require one", bSetWithEngine && bRejectedWithoutEngine && bPrimitiveWithoutEngine );
+}
+
+void CASBehaviorTests::TestTypedReturnValues()
+{
+	bool bRead = false;
+	bool bMismatchRejected = false;
+
+	if( auto pFunction = GetFunction( "AddOne" ) )
+	{
+		int iFirst = 0;
+		int iSecond = 0;
+
+		//The second call uses the return type that was checked by the first.
+		bRead = as::CallAndReturn<int, int>( pFunction, iFirst, 1 ) && as::CallAndReturn<int, int>( pFunction, iSecond, 5 ) &&
+			iFirst == 2 && iSecond == 6;
+
+		float flResult = 0;
+
+		bMismatchRejected = !as::CallAndReturn<float, int>( pFunction, flResult, 1 );
+	}
+
+	Check( "Typed return values are read with the function's return type, and other types are rejected", bRead && bMismatchRejected );
+}
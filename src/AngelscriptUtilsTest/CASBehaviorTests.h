@@ -0,0 +1,110 @@
+#ifndef TEST_CASBEHAVIORTESTS_H
+#define TEST_CASBEHAVIORTESTS_H
+
+class asIScriptFunction;
+class CASEvent;
+class CASManager;
+class CASModule;
+
+/*
+*	Checks that the library behaves as expected, run by the test program after the test script has been used.
+*	Each check prints whether it passed. The test program's exit code is non-zero if any check failed.
+*/
+class CASBehaviorTests final
+{
+public:
+	/**
+	*	Constructor.
+	*	@param manager Initialized manager.
+	*	@param module Module built from the test script.
+	*/
+	CASBehaviorTests( CASManager& manager, CASModule& module )
+		: m_Manager( manager )
+		, m_Module( module )
+	{
+	}
+
+	/**
+	*	Runs all checks.
+	*	@return Whether all checks passed.
+	*/
+	bool Run();
+
+	/**
+	*	@return The number of checks that failed.
+	*/
+	unsigned int GetFailedCount() const { return m_uiFailed; }
+
+private:
+	void Check( const char* pszName, const bool bPassed );
+
+	/**
+	*	@return The BehaviorCount event created by the test script, or null if it doesn't exist.
+	*/
+	CASEvent* GetCountEvent() const;
+
+	/**
+	*	@return The given function in the test script, or null if it doesn't exist.
+	*/
+	asIScriptFunction* GetFunction( const char* pszName ) const;
+
+	/**
+	*	@return The given global int in the test script, or null if it doesn't exist.
+	*/
+	int* GetGlobalInt( const char* pszName ) const;
+
+	void TestTemporaryFunctionEventLookup();
+
+	void TestNestedCalls();
+
+	void TestOwningContextNesting();
+
+	void TestDeferredEventBudget();
+
+	void TestReplacedContextPool();
+
+	void TestTypedArgumentTraits();
+
+	void TestUnhookedEventCall();
+
+	void TestEventLookup();
+
+	void TestEventStats();
+
+	void TestKeyedDispatch();
+
+	void TestUnhookModuleFunctions();
+
+	void TestSuspendedModuleHooks();
+
+	void TestScriptEvent();
+
+	void TestTargetedDispatch();
+
+	void TestTypedCallSignature();
+
+	void TestBoundCall();
+
+	void TestContextPoolReuse();
+
+	void TestInlineArguments();
+
+	void TestArgumentMoves();
+
+	void TestArgumentEngine();
+
+	void TestTypedReturnValues();
+
+private:
+	CASManager& m_Manager;
+	CASModule& m_Module;
+
+	unsigned int m_uiPassed = 0;
+	unsigned int m_uiFailed = 0;
+
+private:
+	CASBehaviorTests( const CASBehaviorTests& ) = delete;
+	CASBehaviorTests& operator=( const CASBehaviorTests& ) = delete;
+};
+
+#endif //TEST_CASBEHAVIORTESTS_H
@@ -0,0 +1,75 @@
+#include <iostream>
+
+#include "AngelscriptUtils/CASLoggingContextResultHandler.h"
+#include "AngelscriptUtils/CASModule.h"
+
+#include "AngelscriptUtils/wrapper/ASCallable.h"
+#include "AngelscriptUtils/wrapper/CASContext.h"
+
+#include "CASTestInitializer.h"
+
+void Print( const std::string& szString )
+{
+	std::cout << szString;
+}
+
+int NSTest()
+{
+	return 0;
+}
+
+bool CallNested( const std::string& szFunctionName, const int iCount )
+{
+	auto pContext = asGetActiveContext();
+
+	if( !pContext )
+		return false;
+
+	auto pModule = GetScriptModuleFromScriptContext( pContext );
+
+	auto pFunction = pModule ? pModule->GetFunctionByName( szFunctionName.c_str() ) : nullptr;
+
+	if( !pFunction )
+		return false;
+
+	CASContext ctx( *pContext );
+
+	CASFunction func( *pFunction, ctx );
+
+	for( int iCall = 0; iCall < iCount; ++iCall )
+	{
+		if( !func.Call( CallFlag::NONE ) || !func.IsNested() || !func.HasFinished() )
+			return false;
+	}
+
+	return true;
+}
+
+bool IsOwningContextBorrowed( const bool bAllowNesting )
+{
+	auto pContext = asGetActiveContext();
+
+	if( !pContext )
+		return false;
+
+	CASOwningContext ctx( *pContext->GetEngine(), bAllowNesting );
+
+	return ctx.IsBorrowed();
+}
+
+void SetupScriptContext( asIScriptContext& context )
+{
+	//TODO: add test to see if suspending will log an error.
+	auto pResultHandler = new CASLoggingContextResultHandler( CASLoggingContextResultHandler::Flag::SUSPEND_IS_ERROR );
+
+	as::SetContextResultHandler( context, pResultHandler );
+
+	pResultHandler->Release();
+}
+
+bool UseEventManager()
+{
+	return USE_EVENT_MANAGER;
+}
+
+CASEvent testEvent( "Main", "const string& in", "", ModuleAccessMask::ALL, EventStopMode::ON_HANDLED );
@@ -0,0 +1,229 @@
+#ifndef TEST_CASTESTINITIALIZER_H
+#define TEST_CASTESTINITIALIZER_H
+
+#include <string>
+
+#include <angelscript.h>
+
+#include "AngelscriptUtils/CASContextPool.h"
+#include "AngelscriptUtils/CASManager.h"
+#include "AngelscriptUtils/CASModule.h"
+#include "AngelscriptUtils/IASInitializer.h"
+#include "AngelscriptUtils/IASModuleBuilder.h"
+
+#include "AngelscriptUtils/add_on/scriptbuilder/scriptbuilder.h"
+
+#include "AngelscriptUtils/event/CASEvent.h"
+#include "AngelscriptUtils/event/CASEventManager.h"
+
+#include "AngelscriptUtils/ScriptAPI/CASScheduler.h"
+#include "AngelscriptUtils/ScriptAPI/Reflection/ASReflection.h"
+
+#include "AngelscriptUtils/util/ASUtil.h"
+
+#include "add_on/scriptany/scriptany.h"
+#include "add_on/scriptarray/scriptarray.h"
+#include "add_on/scriptdictionary/scriptdictionary.h"
+#include "add_on/scriptstdstring/scriptstdstring.h"
+
+#include "ASCBaseEntity.h"
+#include "CScriptBaseEntity.h"
+
+/*
+*	Engine setup shared by the test program and the replay tool, so traces recorded by one can be replayed by the other.
+*/
+
+namespace ModuleAccessMask
+{
+/**
+*	Access masks for modules.
+*/
+enum ModuleAccessMask
+{
+	/**
+	*	No access.
+	*/
+	NONE			= 0,
+
+	/**
+	*	Shared API.
+	*/
+	SHARED			= 1 << 0,
+
+	/**
+	*	Map script specific.
+	*/
+	MAPSCRIPT_ONLY	= 1 << 1,
+
+	MAPSCRIPT		= SHARED | MAPSCRIPT_ONLY,
+
+	/**
+	*	Plugin script specific.
+	*/
+	PLUGIN_ONLY		= 1 << 2,
+
+	PLUGIN			= SHARED | PLUGIN_ONLY,
+
+	/**
+	*	All scripts.
+	*/
+	ALL			= SHARED | MAPSCRIPT | PLUGIN
+};
+}
+
+void Print( const std::string& szString );
+
+int NSTest();
+
+/*
+*	Calls a function in the calling script's module the given number of times, nested on the calling script's context.
+*	The same callable is used for all calls.
+*/
+bool CallNested( const std::string& szFunctionName, const int iCount );
+
+/*
+*	Returns whether a CASOwningContext created while a script is executing borrows the script's context.
+*/
+bool IsOwningContextBorrowed( const bool bAllowNesting );
+
+void SetupScriptContext( asIScriptContext& context );
+
+const bool USE_EVENT_MANAGER = true;
+
+//This gets around conditional expression is constant warnings
+bool UseEventManager();
+
+/*
+*	An event to test out the event system.
+*	Stops as soon as it's handled.
+*	Can be hooked by calling Events::Main.Hook( @MainHook( ... ) );
+*/
+extern CASEvent testEvent;
+
+class CASTestInitializer : public IASInitializer
+{
+public:
+	CASTestInitializer( CASManager& manager )
+		: m_Manager( manager )
+	{
+	}
+
+	bool UseEventManager() override { return USE_EVENT_MANAGER; }
+
+	void ConfigureContextPool( CASContextPool& pool ) override
+	{
+		pool.SetContextCreatedCallback( &::SetupScriptContext );
+	}
+
+	bool RegisterCoreAPI( CASManager& manager ) override
+	{
+		RegisterStdString( manager.GetEngine() );
+		RegisterScriptArray( manager.GetEngine(), true );
+		RegisterScriptDictionary( manager.GetEngine() );
+		RegisterScriptAny( manager.GetEngine() );
+		RegisterScriptScheduler( manager.GetEngine() );
+		RegisterScriptReflection( *manager.GetEngine() );
+
+		RegisterScriptEventAPI( *manager.GetEngine() );
+
+		manager.GetEngine()->RegisterTypedef( "size_t", "uint32" );
+
+		return true;
+	}
+
+	bool AddEvents( CASManager&, CASEventManager& eventManager ) override
+	{
+		//Add an event. Scripts will be able to hook these, when it's invoked by C++ code all hooked functions are called.
+		eventManager.AddEvent( &testEvent );
+
+		return true;
+	}
+
+	bool RegisterAPI( CASManager& manager ) override
+	{
+		auto pEngine = manager.GetEngine();
+
+		//Printing function.
+		pEngine->RegisterGlobalFunction( "void Print(const string& in szString)", asFUNCTION( Print ), asCALL_CDECL );
+
+		pEngine->SetDefaultNamespace( "NS" );
+
+		pEngine->RegisterGlobalFunction( 
+			"int NSTest()", 
+			asFUNCTION( NSTest ),
+			asCALL_CDECL );
+
+		pEngine->SetDefaultNamespace( "" );
+
+		pEngine->RegisterGlobalFunction( "bool CallNested(const string& in szFunctionName, int iCount)", asFUNCTION( CallNested ), asCALL_CDECL );
+		pEngine->RegisterGlobalFunction( "bool IsOwningContextBorrowed(bool bAllowNesting)", asFUNCTION( IsOwningContextBorrowed ), asCALL_CDECL );
+
+		//Register the interface that all custom entities use. Allows you to take them as handles to functions.
+		pEngine->RegisterInterface( "IScriptEntity" );
+
+		//Register the entity class.
+		RegisterScriptCBaseEntity( *pEngine );
+
+		//Register the entity base class. Used to call base class implementations.
+		RegisterScriptBaseEntity( *pEngine );
+
+		return true;
+	}
+
+private:
+	CASManager& m_Manager;
+
+private:
+	CASTestInitializer( const CASTestInitializer& ) = delete;
+	CASTestInitializer& operator=( const CASTestInitializer& ) = delete;
+};
+
+/**
+*	Builder for the test script.
+*/
+class CASTestModuleBuilder : public IASModuleBuilder
+{
+public:
+	CASTestModuleBuilder( const std::string& szDecl )
+		: m_szDecl( szDecl )
+	{
+	}
+
+	bool AddScripts( CScriptBuilder& builder ) override
+	{
+		//By using a handle this can be changed, but since there are no other instances, it can only be made null.
+		//TODO: figure out a better way.
+		auto result = builder.AddSectionFromMemory( 
+			"__Globals", 
+			"CScheduler@ Scheduler;" );
+
+		if( result < 0 )
+			return false;
+
+		if( builder.AddSectionFromMemory(
+			"__CScriptBaseEntity",
+			m_szDecl.c_str() ) < 0 )
+			return false;
+
+		return builder.AddSectionFromFile( "resources/scripts/test.as" ) >= 0;
+	}
+
+	bool PostBuild( CScriptBuilder&, const bool bSuccess, CASModule* pModule ) override
+	{
+		if( !bSuccess )
+			return false;
+
+		auto& scriptModule = *pModule->GetModule();
+
+		//Set the scheduler instance.
+		if( !as::SetGlobalByName( scriptModule, "Scheduler", pModule->GetScheduler() ) )
+			return false;
+
+		return true;
+	}
+
+private:
+	std::string m_szDecl;
+};
+
+#endif //TEST_CASTESTINITIALIZER_H
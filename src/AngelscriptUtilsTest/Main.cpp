@@ -1,4 +1,6 @@
+#include <cstring>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include <spdlog/spdlog.h>
@@ -10,6 +12,7 @@
 #include "AngelscriptUtils/CASManager.h"
 #include "AngelscriptUtils/event/CASEvent.h"
 #include "AngelscriptUtils/event/CASEventCaller.h"
+#include "AngelscriptUtils/event/CASEventManager.h"
 #include "AngelscriptUtils/CASModule.h"
 #include "AngelscriptUtils/CASLoggingContextResultHandler.h"
 #include "AngelscriptUtils/IASInitializer.h"
@@ -39,212 +42,8 @@
 #include "CBaseEntity.h"
 #include "CScriptBaseEntity.h"
 #include "ASCBaseEntity.h"
-
-namespace ModuleAccessMask
-{
-/**
-*	Access masks for modules.
-*/
-enum ModuleAccessMask
-{
-	/**
-	*	No access.
-	*/
-	NONE			= 0,
-
-	/**
-	*	Shared API.
-	*/
-	SHARED			= 1 << 0,
-
-	/**
-	*	Map script specific.
-	*/
-	MAPSCRIPT_ONLY	= 1 << 1,
-
-	MAPSCRIPT		= SHARED | MAPSCRIPT_ONLY,
-
-	/**
-	*	Plugin script specific.
-	*/
-	PLUGIN_ONLY		= 1 << 2,
-
-	PLUGIN			= SHARED | PLUGIN_ONLY,
-
-	/**
-	*	All scripts.
-	*/
-	ALL			= SHARED | MAPSCRIPT | PLUGIN
-};
-}
-
-void Print( const std::string& szString )
-{
-	std::cout << szString;
-}
-
-int NSTest()
-{
-	return 0;
-}
-
-asIScriptContext* CreateScriptContext( asIScriptEngine* pEngine, void* )
-{
-	auto pContext = pEngine->CreateContext();
-
-	//TODO: add test to see if suspending will log an error.
-	auto pResultHandler = new CASLoggingContextResultHandler( CASLoggingContextResultHandler::Flag::SUSPEND_IS_ERROR );
-
-	as::SetContextResultHandler( *pContext, pResultHandler );
-
-	pResultHandler->Release();
-
-	return pContext;
-}
-
-void DestroyScriptContext( asIScriptEngine*, asIScriptContext* pContext, void* )
-{
-	if( pContext )
-		pContext->Release();
-}
-
-const bool USE_EVENT_MANAGER = true;
-
-//This gets around conditional expression is constant warnings
-bool UseEventManager()
-{
-	return USE_EVENT_MANAGER;
-}
-
-/*
-*	An event to test out the event system.
-*	Stops as soon as it's handled.
-*	Can be hooked by calling Events::Main.Hook( @MainHook( ... ) );
-*/
-CASEvent testEvent( "Main", "const string& in", "", ModuleAccessMask::ALL, EventStopMode::ON_HANDLED );
-
-class CASTestInitializer : public IASInitializer
-{
-public:
-	CASTestInitializer( CASManager& manager )
-		: m_Manager( manager )
-	{
-	}
-
-	bool UseEventManager() override { return USE_EVENT_MANAGER; }
-
-	void OnInitBegin()
-	{
-		m_Manager.GetEngine()->SetContextCallbacks( &::CreateScriptContext, &::DestroyScriptContext );
-	}
-
-	bool RegisterCoreAPI( CASManager& manager ) override
-	{
-		RegisterStdString( manager.GetEngine() );
-		RegisterScriptArray( manager.GetEngine(), true );
-		RegisterScriptDictionary( manager.GetEngine() );
-		RegisterScriptAny( manager.GetEngine() );
-		RegisterScriptScheduler( manager.GetEngine() );
-		RegisterScriptReflection( *manager.GetEngine() );
-
-		RegisterScriptEventAPI( *manager.GetEngine() );
-
-		manager.GetEngine()->RegisterTypedef( "size_t", "uint32" );
-
-		return true;
-	}
-
-	bool AddEvents( CASManager&, CASEventManager& eventManager ) override
-	{
-		//Add an event. Scripts will be able to hook these, when it's invoked by C++ code all hooked functions are called.
-		eventManager.AddEvent( &testEvent );
-
-		return true;
-	}
-
-	bool RegisterAPI( CASManager& manager ) override
-	{
-		auto pEngine = manager.GetEngine();
-
-		//Printing function.
-		pEngine->RegisterGlobalFunction( "void Print(const string& in szString)", asFUNCTION( Print ), asCALL_CDECL );
-
-		pEngine->SetDefaultNamespace( "NS" );
-
-		pEngine->RegisterGlobalFunction( 
-			"int NSTest()", 
-			asFUNCTION( NSTest ),
-			asCALL_CDECL );
-
-		pEngine->SetDefaultNamespace( "" );
-
-		//Register the interface that all custom entities use. Allows you to take them as handles to functions.
-		pEngine->RegisterInterface( "IScriptEntity" );
-
-		//Register the entity class.
-		RegisterScriptCBaseEntity( *pEngine );
-
-		//Register the entity base class. Used to call base class implementations.
-		RegisterScriptBaseEntity( *pEngine );
-
-		return true;
-	}
-
-private:
-	CASManager& m_Manager;
-
-private:
-	CASTestInitializer( const CASTestInitializer& ) = delete;
-	CASTestInitializer& operator=( const CASTestInitializer& ) = delete;
-};
-
-/**
-*	Builder for the test script.
-*/
-class CASTestModuleBuilder : public IASModuleBuilder
-{
-public:
-	CASTestModuleBuilder( const std::string& szDecl )
-		: m_szDecl( szDecl )
-	{
-	}
-
-	bool AddScripts( CScriptBuilder& builder ) override
-	{
-		//By using a handle this can be changed, but since there are no other instances, it can only be made null.
-		//TODO: figure out a better way.
-		auto result = builder.AddSectionFromMemory( 
-			"__Globals", 
-			"CScheduler@ Scheduler;" );
-
-		if( result < 0 )
-			return false;
-
-		if( builder.AddSectionFromMemory(
-			"__CScriptBaseEntity",
-			m_szDecl.c_str() ) < 0 )
-			return false;
-
-		return builder.AddSectionFromFile( "resources/scripts/test.as" ) >= 0;
-	}
-
-	bool PostBuild( CScriptBuilder&, const bool bSuccess, CASModule* pModule ) override
-	{
-		if( !bSuccess )
-			return false;
-
-		auto& scriptModule = *pModule->GetModule();
-
-		//Set the scheduler instance.
-		if( !as::SetGlobalByName( scriptModule, "Scheduler", pModule->GetScheduler() ) )
-			return false;
-
-		return true;
-	}
-
-private:
-	std::string m_szDecl;
-};
+#include "CASBehaviorTests.h"
+#include "CASTestInitializer.h"
 
 class CASModuleUserData : public IASModuleUserData
 {
@@ -265,8 +64,17 @@ public:
 	}
 };
 
-int main( int, char*[] )
+int main( int argc, char* argv[] )
 {
+	//--record <file>: record all event calls to a trace. Traces can be replayed with AngelscriptUtilsReplay.
+	std::string szRecordFilename;
+
+	for( int iArg = 1; iArg < argc; ++iArg )
+	{
+		if( strcmp( argv[ iArg ], "--record" ) == 0 && iArg + 1 < argc )
+			szRecordFilename = argv[ ++iArg ];
+	}
+
 	{
 		auto console = std::make_shared<spdlog::sinks::stdout_sink_mt>();
 		auto file = std::make_shared<spdlog::sinks::daily_file_sink_mt>( "logs/L", 0, 0 );
@@ -280,6 +88,8 @@ int main( int, char*[] )
 
 	std::cout << "Hello World!" << std::endl;
 
+	int iResult = 0;
+
 	CASManager manager;
 
 	CASTestInitializer initializer( manager );
@@ -306,6 +116,9 @@ int main( int, char*[] )
 
 		auto pModule = manager.GetModuleManager().BuildModule( "MapScript", "MapModule", builder, new CASModuleUserData() );
 
+		if( pModule && UseEventManager() && !szRecordFilename.empty() )
+			manager.GetEventManager()->StartRecording( szRecordFilename );
+
 		if( pModule )
 		{
 			//Call the main function.
@@ -325,6 +138,22 @@ int main( int, char*[] )
 					CASEventCaller caller;
 
 					caller.Call( testEvent, pEngine, &szString, true );
+
+					//Hook a function that always throws, and trigger the event until it has failed often enough to be quarantined.
+					if( auto pThrowingHook = pModule->GetModule()->GetFunctionByName( "ThrowingHook" ) )
+					{
+						testEvent.RemoveFunction( pFunction );
+						testEvent.AddFunction( pThrowingHook );
+
+						for( uint32_t uiCall = 0; uiCall < testEvent.GetQuarantineThreshold(); ++uiCall )
+						{
+							caller.Call( testEvent, pEngine, &szString, true );
+						}
+
+						std::cout << "Throwing hook quarantined: " << ( testEvent.GetQuarantinedHookCount() == 1 ? "yes" : "no" ) << std::endl;
+
+						testEvent.RemoveFunction( pThrowingHook );
+					}
 				}
 			}
 
@@ -498,6 +327,17 @@ int main( int, char*[] )
 
 			manager.GetEventManager()->DumpHookedFunctions();
 
+			manager.GetEventManager()->StopRecording();
+
+			const auto poolStats = manager.GetContextPool()->GetStats();
+
+			std::cout << "Context pool: " << poolStats.uiHits << " hits, " << poolStats.uiMisses << " misses, peak in use " << poolStats.uiPeakInUse << std::endl;
+
+			CASBehaviorTests tests( manager, *pModule );
+
+			if( !tests.Run() )
+				iResult = 1;
+
 			//Remove the module.
 			manager.GetModuleManager().RemoveModule( pModule );
 		}
@@ -513,5 +353,5 @@ int main( int, char*[] )
 	//Wait for input.
 	getchar();
 
-	return 0;
+	return iResult;
 }
\ No newline at end of file